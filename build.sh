@@ -73,6 +73,9 @@ function main() {
         "valve")     # build valve_control
             run_build_task  valve_controller  ${INSTALL_DIR}/valve_controller/bin
             ;;
+        "decoder")     # build log_decoder (host-tool for binary log-file)
+            run_build_task  log_decoder  ${INSTALL_DIR}/log_decoder/bin
+            ;;
         "none")
             echo -e "\e[1;31m [ERROR] We need BUILD_TARGET. Please, insert -t option. \e[0m"
             exit 1
@@ -9,4 +9,8 @@ equals(TARGET, "cmd_scheduler") {
     SUBDIRS += cmd_scheduler
 }
 
+equals(TARGET, "log_decoder") {
+    SUBDIRS += log_decoder
+}
+
 DISTFILES += \
\ No newline at end of file
@@ -41,6 +41,7 @@ equals(CPU_ARCH,"x86") {
 equals(BUILD_MODE, "debug") {
     DEFINES += LOG_TIME_ENABLE
     DEFINES += LOG_DEBUG_MODE
+    DEFINES += LOG_ASYNC_ENABLE
     DEFINES += LOG_LEVEL=$$LOG_LEVEL_DEBUG
 }
 
@@ -76,6 +77,7 @@ SOURCES += \
     $$files($$COMMON_LIB_ROOT/principle/contents/*.cpp)  \
     $$files($$COMMON_LIB_ROOT/principle/*.cpp)  \
     $$files($$COMMON_LIB_ROOT/CuCMD/*.cpp)   \
+    $$files($$COMMON_LIB_ROOT/lib/logger/*.cpp) \
     $$files($$COMMON_LIB_ROOT/lib/gps/*.cpp) \
     $$files($$COMMON_LIB_ROOT/lib/sqlite/*.cpp) \
     $$files($$COMMON_LIB_ROOT/lib/uart/*.cpp) \
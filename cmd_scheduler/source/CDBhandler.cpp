@@ -12,54 +12,40 @@ constexpr const char * CDBhandler::DB_TABLE_PERIOD;
 constexpr const char * CDBhandler::DB_NAME_FUTURE;
 constexpr const char * CDBhandler::DB_NAME_NOW;
 constexpr const char * CDBhandler::DB_NAME_PAST;
+constexpr const char * CDBhandler::DB_SCHEMA_NOW;
 
 constexpr const char * CDBhandler::TABLE_MODEL_FUTURE[];
 constexpr const char * CDBhandler::TABLE_MODEL_NOW[];
 constexpr const char * CDBhandler::TABLE_MODEL_PAST[];
 
+constexpr int CDBhandler::DB_SCHEMA_VERSION;
+constexpr const char * CDBhandler::INDEX_MODEL_FUTURE[];
+constexpr const char * CDBhandler::INDEX_MODEL_NOW[];
+constexpr const char * CDBhandler::INDEX_MODEL_PAST[];
 
-// define KEYs
-#define KEYS_FUTURE_EVENT   KEY_UUID","KEY_WHO","KEY_WHEN_TEXT","KEY_WHEN","   \
-                            KEY_WHERE","KEY_WHAT","KEY_HOW","KEY_PAYLOAD
-#define KEYS_FUTURE_PERIOD  KEY_UUID","KEY_WHO","KEY_PERIOD_TYPE","    \
-                            KEY_PERIOD","KEY_FIRSTWHEN","KEY_WHEN","KEY_WHERE","    \
-                            KEY_WHAT","KEY_HOW","KEY_PAYLOAD
-#define KEYS_NOW_EVENT      KEYS_FUTURE_EVENT","KEY_MSG_ID","KEY_STATE
-#define KEYS_PAST_EVENT     KEYS_FUTURE_EVENT","KEY_MSG_ID","KEY_STATE
-
-const std::map<CDBhandler::Tkey, std::string> CDBhandler::_gm_key_names_all_ = {
-    {CDBhandler::Tkey::ENUM_ID, KEY_ID},
-    {CDBhandler::Tkey::ENUM_UUID, KEY_UUID},
-    {CDBhandler::Tkey::ENUM_WHO, KEY_WHO},
-    {CDBhandler::Tkey::ENUM_WHEN_TEXT, KEY_WHEN_TEXT},
-    {CDBhandler::Tkey::ENUM_WHEN, KEY_WHEN},
-    {CDBhandler::Tkey::ENUM_WHERE, KEY_WHERE},
-    {CDBhandler::Tkey::ENUM_WHAT, KEY_WHAT},
-    {CDBhandler::Tkey::ENUM_HOW, KEY_HOW},
-    {CDBhandler::Tkey::ENUM_PAYLOAD, KEY_PAYLOAD},
-
-    {CDBhandler::Tkey::ENUM_FIRSTWHEN, KEY_FIRSTWHEN},
-    {CDBhandler::Tkey::ENUM_MSG_ID, KEY_MSG_ID},
-    {CDBhandler::Tkey::ENUM_PERIOD, KEY_PERIOD},
-    {CDBhandler::Tkey::ENUM_PERIOD_TYPE, KEY_PERIOD_TYPE},
-    {CDBhandler::Tkey::ENUM_STATE, KEY_STATE}
-};
 
-const std::map<CDBhandler::Ttype, std::map<CDBhandler::Tkey, std::string>> CDBhandler::_gm_key_names_ = {
-    {CDBhandler::Ttype::ENUM_FUTURE, {
-                                        {CDBhandler::Tkey::ENUM_ID, KEY_ID},
-                                        {CDBhandler::Tkey::ENUM_UUID, KEY_UUID},
-                                        {CDBhandler::Tkey::ENUM_WHO, KEY_WHO},
-                                        {CDBhandler::Tkey::ENUM_WHEN_TEXT, KEY_WHEN_TEXT},
-                                        {CDBhandler::Tkey::ENUM_WHEN, KEY_WHEN},
-                                        {CDBhandler::Tkey::ENUM_WHERE, KEY_WHERE},
-                                        {CDBhandler::Tkey::ENUM_WHAT, KEY_WHAT},
-                                        {CDBhandler::Tkey::ENUM_HOW, KEY_HOW},
-                                        {CDBhandler::Tkey::ENUM_PAYLOAD, KEY_PAYLOAD}
-                                    }
-    },
-    {CDBhandler::Ttype::ENUM_NOW, std::map<CDBhandler::Tkey, std::string>()},
-    {CDBhandler::Ttype::ENUM_PAST, std::map<CDBhandler::Tkey, std::string>()}
+// define Layout of tables. (Order of columns in query)
+const CLayout CDBhandler::LAYOUT_FUTURE_EVENT = { Tkey::ENUM_UUID, Tkey::ENUM_WHO, Tkey::ENUM_WHEN_TEXT, Tkey::ENUM_WHEN, 
+                                                  Tkey::ENUM_WHERE, Tkey::ENUM_WHAT, Tkey::ENUM_HOW, Tkey::ENUM_PAYLOAD };
+
+const CLayout CDBhandler::LAYOUT_FUTURE_PERIOD = { Tkey::ENUM_UUID, Tkey::ENUM_WHO, Tkey::ENUM_PERIOD_TYPE, Tkey::ENUM_PERIOD, 
+                                                   Tkey::ENUM_FIRSTWHEN, Tkey::ENUM_WHEN, Tkey::ENUM_WHERE, 
+                                                   Tkey::ENUM_WHAT, Tkey::ENUM_HOW, Tkey::ENUM_PAYLOAD };
+
+// NOW/PAST layout = FUTURE_EVENT layout + msg_id + state
+const CLayout CDBhandler::LAYOUT_NOW_EVENT = { Tkey::ENUM_UUID, Tkey::ENUM_WHO, Tkey::ENUM_WHEN_TEXT, Tkey::ENUM_WHEN, 
+                                               Tkey::ENUM_WHERE, Tkey::ENUM_WHAT, Tkey::ENUM_HOW, Tkey::ENUM_PAYLOAD,
+                                               Tkey::ENUM_MSG_ID, Tkey::ENUM_STATE };
+
+const CLayout CDBhandler::LAYOUT_PAST_EVENT = { Tkey::ENUM_UUID, Tkey::ENUM_WHO, Tkey::ENUM_WHEN_TEXT, Tkey::ENUM_WHEN, 
+                                                Tkey::ENUM_WHERE, Tkey::ENUM_WHAT, Tkey::ENUM_HOW, Tkey::ENUM_PAYLOAD,
+                                                Tkey::ENUM_MSG_ID, Tkey::ENUM_STATE };
+
+const std::map<CDBhandler::Ttype, std::map<std::string, const CLayout*>> CDBhandler::_gm_layouts_ = {
+    {CDBhandler::Ttype::ENUM_FUTURE, { {TABLE_EVENT, &CDBhandler::LAYOUT_FUTURE_EVENT}, 
+                                       {TABLE_PERIOD, &CDBhandler::LAYOUT_FUTURE_PERIOD} } },
+    {CDBhandler::Ttype::ENUM_NOW, { {TABLE_EVENT, &CDBhandler::LAYOUT_NOW_EVENT} } },
+    {CDBhandler::Ttype::ENUM_PAST, { {TABLE_EVENT, &CDBhandler::LAYOUT_PAST_EVENT} } }
 };
 
 
@@ -71,9 +57,9 @@ CDBhandler::CDBhandler( void ) {
         std::vector<std::string> db_list;
 
         // Create DBs
-        _mm_db_[Ttype::ENUM_FUTURE] = std::make_shared<db_pkg::CDBsqlite>(DB_NAME_FUTURE, TABLE_MODEL_FUTURE);
-        _mm_db_[Ttype::ENUM_NOW] = std::make_shared<db_pkg::CDBsqlite>(DB_NAME_NOW, TABLE_MODEL_NOW);
-        _mm_db_[Ttype::ENUM_PAST] = std::make_shared<db_pkg::CDBsqlite>(DB_NAME_PAST, TABLE_MODEL_PAST);
+        _mm_db_[Ttype::ENUM_FUTURE] = std::make_shared<db_pkg::CDBsqlite>(DB_NAME_FUTURE, TABLE_MODEL_FUTURE, INDEX_MODEL_FUTURE, DB_SCHEMA_VERSION);
+        _mm_db_[Ttype::ENUM_NOW] = std::make_shared<db_pkg::CDBsqlite>(DB_NAME_NOW, TABLE_MODEL_NOW, INDEX_MODEL_NOW, DB_SCHEMA_VERSION);
+        _mm_db_[Ttype::ENUM_PAST] = std::make_shared<db_pkg::CDBsqlite>(DB_NAME_PAST, TABLE_MODEL_PAST, INDEX_MODEL_PAST, DB_SCHEMA_VERSION);
         if( _mm_db_[Ttype::ENUM_FUTURE].get() == NULL || _mm_db_[Ttype::ENUM_NOW].get() == NULL || _mm_db_[Ttype::ENUM_PAST].get() == NULL ) {
             throw std::runtime_error("CDBsqlite memory-allocation is failed.");
         }
@@ -91,6 +77,12 @@ CDBhandler::CDBhandler( void ) {
         for( auto itr=_mm_db_.begin(); itr!=_mm_db_.end(); itr++ ) {
             itr->second->start();
         }
+
+        // PAST-DB connection moves records from NOW-DB to itself.
+        attach_now_to_past();
+
+        // Hot queries must use indexes.
+        check_query_plans();
     }
     catch( const std::exception& e ) {
         LOGERR("%s", e.what());
@@ -108,14 +100,13 @@ bool CDBhandler::convert_record_to_event(Ttype db_type, Trecord& record, double
     bool res = false;
 
     try {
-        std::string uuid;
-        Trecord new_record;
+        std::string when_text;
         if( db_type != Ttype::ENUM_FUTURE ) {
             std::string err = "NOT Supported DataBase Type. (" + std::to_string(static_cast<uint8_t>(db_type)) + ")";
             throw std::out_of_range(err);
         }
 
-        if( record.size() == 0 ) {
+        if( record.mask() == 0 ) {
             throw std::invalid_argument("record have not any keys. It's empty.");
         }
 
@@ -123,34 +114,19 @@ bool CDBhandler::convert_record_to_event(Ttype db_type, Trecord& record, double
             std::string err = "'when' is invalid-value. (" + std::to_string(when) + ")";
             throw std::invalid_argument(err);
         }
-    
-        auto itr = _gm_key_names_.find(db_type);
-        if( itr == _gm_key_names_.end() || itr->second.size() <= 0 ) {
-            std::string err = "Not exist key_names in mapper of " + std::to_string(static_cast<uint8_t>(db_type));
-            throw std::logic_error(err);
-        }
 
-        // extract key,value only for eventbase table from record to new_record.
-        uuid = get_uuid(record);
-        record[KEY_WHEN] = std::to_string(when);
-        record[KEY_WHEN_TEXT] = time_pkg::CTime::print<double>(when, "%Y-%m-%d %T");
-        record[KEY_UUID] = uuid + "@" + record[KEY_WHEN_TEXT];
+        // update 'when' & uuid for eventbase table.
+        when_text = time_pkg::CTime::print<double>(when, "%Y-%m-%d %T");
+        record.set<Tkey::ENUM_UUID>( record.get<Tkey::ENUM_UUID>() + "@" + when_text );
+        record.set<Tkey::ENUM_WHEN>( when );
+        record.set<Tkey::ENUM_WHEN_TEXT>( when_text );
 
-        for( auto eitr=itr->second.begin(); eitr!=itr->second.end(); eitr++ ) {
-            auto kitr = record.find( eitr->second );
-            if( kitr == record.end() ) {
-                std::string err = "key(" + eitr->second + ") have to exist in record. But it's not exist.";
-                throw std::logic_error(err);
-            }
-
-            new_record[eitr->second] = kitr->second;
-        }
-
-        // update record by new_record.
-        record.clear();
-        for(auto eitr=new_record.begin(); eitr!=new_record.end(); eitr++) {
-            record[eitr->first] = eitr->second;
+        // keep columns only for eventbase table.
+        if( record.has_all( LAYOUT_FUTURE_EVENT.mask() ) == false ) {
+            throw std::logic_error("There is not exist MANDATORY KEY of EventBase in record.");
         }
+        record.retain( LAYOUT_FUTURE_EVENT.mask() );
+        res = true;
     }
     catch( const std::exception& e ) {
         LOGERR("%s", e.what());
@@ -159,8 +135,8 @@ bool CDBhandler::convert_record_to_event(Ttype db_type, Trecord& record, double
     return res;
 }
 
-std::shared_ptr<CDBhandler::Trecord> CDBhandler::make_base_record(std::shared_ptr<cmd::ICommand>& cmd) {
-    std::shared_ptr<CDBhandler::Trecord> record;
+CDBhandler::Trecord CDBhandler::make_base_record(std::shared_ptr<cmd::ICommand>& cmd) {
+    Trecord record;
 
     auto lamda_get_what = [&](void) -> std::string {
         std::string type = cmd->what().get_type();
@@ -191,20 +167,16 @@ std::shared_ptr<CDBhandler::Trecord> CDBhandler::make_base_record(std::shared_pt
             throw std::invalid_argument("cmd is NULL. please check it.");
         }
 
-        record = std::make_shared<Trecord>();
-        if( record.get() == NULL ) {
-            throw std::runtime_error("record memory-allocation is failed.");
-        }
-
         // make base record. (It's depend on EventTable.)
-        (*record)[KEY_WHO] = cmd->who().get_app() + "/" + cmd->who().get_pvd();
-        (*record)[KEY_WHEN] = std::to_string(cmd->when().get_start_time());
-        (*record)[KEY_WHEN_TEXT] = cmd->when().get_date() + " " + cmd->when().get_time();
-        (*record)[KEY_WHERE] = cmd->where().get_type();
-        (*record)[KEY_WHAT] = lamda_get_what();
-        (*record)[KEY_HOW] = lamda_get_how();
-        (*record)[KEY_PAYLOAD] = cmd->get_payload();
-        (*record)[KEY_UUID] = (*record)[KEY_WHO] + "@" + (*record)[KEY_WHEN_TEXT] + "@" + (*record)[KEY_WHERE] + "@" + (*record)[KEY_WHAT] + "@" + (*record)[KEY_HOW];
+        record.set<Tkey::ENUM_WHO>( cmd->who().get_app() + "/" + cmd->who().get_pvd() );
+        record.set<Tkey::ENUM_WHEN>( cmd->when().get_start_time() );
+        record.set<Tkey::ENUM_WHEN_TEXT>( cmd->when().get_date() + " " + cmd->when().get_time() );
+        record.set<Tkey::ENUM_WHERE>( cmd->where().get_type() );
+        record.set<Tkey::ENUM_WHAT>( lamda_get_what() );
+        record.set<Tkey::ENUM_HOW>( lamda_get_how() );
+        record.set<Tkey::ENUM_PAYLOAD>( cmd->get_json_payload() );
+        record.set<Tkey::ENUM_UUID>( record.get<Tkey::ENUM_WHO>() + "@" + record.get<Tkey::ENUM_WHEN_TEXT>() + "@" + record.get<Tkey::ENUM_WHERE>() 
+                                     + "@" + record.get<Tkey::ENUM_WHAT>() + "@" + record.get<Tkey::ENUM_HOW>() );
     }
     catch( const std::exception& e ) {
         LOGERR("%s", e.what());
@@ -215,7 +187,7 @@ std::shared_ptr<CDBhandler::Trecord> CDBhandler::make_base_record(std::shared_pt
 }
 
 /// Setter
-void CDBhandler::insert_record(Ttype db_type, const char* table_name, std::shared_ptr<Trecord>& record) {
+void CDBhandler::insert_record(Ttype db_type, const char* table_name, Trecord& record) {
     try {
         std::string table;
         std::string context;
@@ -224,10 +196,6 @@ void CDBhandler::insert_record(Ttype db_type, const char* table_name, std::share
             throw std::invalid_argument("Table Name is NULL.");
         }
 
-        if( record.get() == NULL ) {
-            throw std::invalid_argument("Record is NULL");
-        }
-
         table = std::string(table_name);
         auto& db_inst = get_db_instance(db_type);
         auto itr = _mm_make_context_4ins_.find(db_type);
@@ -242,9 +210,13 @@ void CDBhandler::insert_record(Ttype db_type, const char* table_name, std::share
             throw std::logic_error(err);
         }
 
+        TVvalue values;
         std::shared_ptr<cmd::ICommand> dumy;
-        context = itr_maker->second(dumy, record);
-        db_inst->query_insert(table + context);
+        context = itr_maker->second(dumy, record, values);
+        if( db_inst->query_insert(table + context, values) != SQLITE_OK ) {
+            std::string err = "query_insert is failed. (INSERT INTO " + table + context + ")";
+            throw std::runtime_error(err);
+        }
     }
     catch( const std::exception& e ) {
         LOGERR("%s", e.what());
@@ -252,7 +224,9 @@ void CDBhandler::insert_record(Ttype db_type, const char* table_name, std::share
     }
 }
 
-void CDBhandler::insert_record(Ttype db_type, const char* table_name, std::shared_ptr<cmd::ICommand>& cmd) {
+CDBhandler::Trecord CDBhandler::insert_record(Ttype db_type, const char* table_name, std::shared_ptr<cmd::ICommand>& cmd) {
+    Trecord record;
+
     try {
         std::string table;
         std::string context;
@@ -279,26 +253,28 @@ void CDBhandler::insert_record(Ttype db_type, const char* table_name, std::share
             throw std::logic_error(err);
         }
 
-        std::shared_ptr<Trecord> dumy;
-        context = itr_maker->second(cmd, dumy);
-        db_inst->query_insert(table + context);
+        TVvalue values;
+        context = itr_maker->second(cmd, record, values);
+        if( db_inst->query_insert(table + context, values) != SQLITE_OK ) {
+            std::string err = "query_insert is failed. (INSERT INTO " + table + context + ")";
+            throw std::runtime_error(err);
+        }
     }
     catch( const std::exception& e ) {
         LOGERR("%s", e.what());
         throw e;
     }
+
+    return record;
 }
 
-void CDBhandler::remove_record(Ttype db_type, const char* table_name, std::shared_ptr<Trecord>& record) {
+void CDBhandler::remove_record(Ttype db_type, const char* table_name, const Trecord& record) {
     try {
-        std::string uuid;
-        auto itr = record->find(KEY_UUID);
-        if( itr == record->end() ) {
+        if( record.has(Tkey::ENUM_UUID) == false ) {
             throw std::invalid_argument("Not Exist UUID key in record.");
         }
 
-        uuid = itr->second;
-        remove_record(db_type, table_name, uuid);
+        remove_record(db_type, table_name, record.get<Tkey::ENUM_UUID>());
     }
     catch( const std::exception& e ) {
         LOGERR("%s", e.what());
@@ -321,10 +297,10 @@ void CDBhandler::remove_record(Ttype db_type, const char* table_name, const std:
 
         table = std::string(table_name);
         auto& db_inst = get_db_instance(db_type);
-        context = table + " WHERE " KEY_UUID " = '" + uuid + "'";
+        context = context_of_remove( table );
 
         // If exist context in DB, then remove it.
-        if( db_inst->query_delete( context ) != SQLITE_OK ) {
+        if( db_inst->query_delete( context, {Tvalue(uuid)} ) != SQLITE_OK ) {
             std::string err = "query_delete is failed. (DELETE FROM " + context + ")";
             throw std::runtime_error(err);
         }
@@ -335,6 +311,51 @@ void CDBhandler::remove_record(Ttype db_type, const char* table_name, const std:
     }
 }
 
+/***
+ * Move a record from NOW-DB to PAST-DB with final state in one transaction.
+ * It's executed by connection of PAST-DB, so PAST-DB is committed before NOW-DB.
+ * (If crash is occured between them, then remained record in NOW-DB is cleaned at next start.)
+ */
+bool CDBhandler::move_record_to_past(uint32_t msg_id, Tstate state) {
+    bool moved = false;
+
+    try {
+        auto& db_past = get_db_instance(Ttype::ENUM_PAST);
+        TVvalue values = { make_value<Tstate>(state), Tvalue( msg_id ) };
+
+        if( db_past->begin_transaction() != SQLITE_OK ) {
+            throw std::runtime_error("begin_transaction is failed.");
+        }
+
+        try {
+            if( db_past->query_insert( context_of_move_copy(), values ) != SQLITE_OK ) {
+                throw std::runtime_error("Copying record from NOW-DB to PAST-DB is failed.");
+            }
+
+            moved = (db_past->changes() > 0);
+            if( moved == true ) {
+                if( db_past->query_delete( context_of_move_remove(), { Tvalue( msg_id ) } ) != SQLITE_OK ) {
+                    throw std::runtime_error("Removing record from NOW-DB is failed.");
+                }
+            }
+        }
+        catch( const std::exception& e ) {
+            db_past->rollback_transaction();
+            throw e;
+        }
+
+        if( db_past->commit_transaction() != SQLITE_OK ) {
+            throw std::runtime_error("commit_transaction is failed.");
+        }
+    }
+    catch( const std::exception& e ) {
+        LOGERR("%s", e.what());
+        throw e;
+    }
+
+    return moved;
+}
+
 /// Getter
 std::shared_ptr<CDBhandler::TVrecord> CDBhandler::get_records(Ttype db_type, const char* table_name, 
                                                               TFPcond& conditioner, TFPconvert convertor, 
@@ -372,23 +393,23 @@ std::shared_ptr<CDBhandler::TVrecord> CDBhandler::get_records(Ttype db_type, con
             }
         }
 
-        db_pkg::IDBsqlite3::TCBselect lamda_func = [&records, &convertor, &db_type](std::shared_ptr<Trecord>& record) -> void {
-            if( convertor != nullptr ) {
-                auto itr_ele = record->find(std::string(KEY_PAYLOAD));
-                if( itr_ele == record->end() ) {
-                    throw std::logic_error("NOT Exist KEY_PAYLOAD in record.");
-                }
+        const CLayout& layout = get_layout(db_type, table);
+        db_pkg::IDBsqlite3::TCBfetch lamda_func = [&records, &convertor, &db_type, &layout](const db_pkg::IDBsqlite3::CStatement& stmt) -> void {
+            Trecord record;
+            layout.load(record, stmt);
 
-                convertor(db_type, *record, itr_ele->second);
+            if( convertor != nullptr ) {
+                convertor(db_type, record, record.at<Tkey::ENUM_PAYLOAD>());
             }
 
             LOGD("push record to record-vector.");
-            records->push_back(record);
+            records->push_back( std::move(record) );
         };
 
-        context = itr_maker->second(conditioner);
-        if( db_inst->query_select( "* FROM " + table + " WHERE " + context, lamda_func ) != SQLITE_OK ) {
-            std::string err = "query_select is failed: SELECT * FROM " + table + " WHERE " + context;
+        TVvalue values;
+        context = context_of_fetch( layout, table, itr_maker->second(conditioner, values) );
+        if( db_inst->query_fetch( context, values, lamda_func ) != SQLITE_OK ) {
+            std::string err = "query_fetch is failed: SELECT " + context;
             throw std::logic_error(err);
         }
     }
@@ -400,55 +421,115 @@ std::shared_ptr<CDBhandler::TVrecord> CDBhandler::get_records(Ttype db_type, con
     return records;
 }
 
-std::shared_ptr<alias::CAlias> CDBhandler::get_who(const Trecord& record) {
-    std::shared_ptr<alias::CAlias> who;
-
+void CDBhandler::get_schedules(Ttype db_type, const char* table_name, TFPschedule func) {
     try {
-        std::string who_str = get_record_data(record, KEY_WHO);
-        who = std::make_shared<alias::CAlias>(who_str);
+        std::string context;
+
+        if( table_name == NULL ) {
+            throw std::invalid_argument("Table Name is NULL.");
+        }
+
+        if( func == nullptr ) {
+            throw std::invalid_argument("schedule function-pointer is NULL");
+        }
+
+        auto& db_inst = get_db_instance(db_type);
+        db_pkg::IDBsqlite3::TCBfetch lamda_func = [&func](const db_pkg::IDBsqlite3::CStatement& stmt) -> void {
+            func( stmt.column_text(0), stmt.column_real(1) );
+        };
+
+        // Load only uuid & when of all records.
+        context = context_of_schedules( table_name );
+        if( db_inst->query_fetch( context, TVvalue(), lamda_func ) != SQLITE_OK ) {
+            std::string err = "query_fetch is failed: SELECT " + context;
+            throw std::logic_error(err);
+        }
     }
     catch( const std::exception& e ) {
         LOGERR("%s", e.what());
         throw e;
     }
-    return who;
 }
 
-std::string CDBhandler::get_payload(const Trecord& record) {
+std::shared_ptr<alias::CAlias> CDBhandler::get_who(const Trecord& record) {
+    std::shared_ptr<alias::CAlias> who;
+
     try {
-        return get_record_data(record, KEY_PAYLOAD);
+        who = std::make_shared<alias::CAlias>( record.get<Tkey::ENUM_WHO>() );
     }
     catch( const std::exception& e ) {
         LOGERR("%s", e.what());
         throw e;
     }
+    return who;
 }
 
-std::string CDBhandler::get_uuid(const Trecord& record) {
-    try {
-        return get_record_data(record, KEY_UUID);
+const std::string& CDBhandler::get_payload(const Trecord& record) {
+    return record.get<Tkey::ENUM_PAYLOAD>();
+}
+
+const std::string& CDBhandler::get_uuid(const Trecord& record) {
+    return record.get<Tkey::ENUM_UUID>();
+}
+
+double CDBhandler::get_when(const Trecord& record) {
+    return record.get<Tkey::ENUM_WHEN>();
+}
+
+const char* CDBhandler::get_state_name(Tstate state) {
+    switch( state ) {
+    case Tstate::ENUM_TRIG:
+        return "TRIGGERED";
+    case Tstate::ENUM_RCV_ACK:
+        return "RCV_ACK";
+    case Tstate::ENUM_STARTED:
+        return "STARTED";
+    case Tstate::ENUM_DONE:
+        return "DONE";
+    case Tstate::ENUM_FAIL:
+        return "FAIL";
+    default:
+        {
+            std::string err = "Not Supported Tstate(" + std::to_string(static_cast<uint32_t>(state)) + ").";
+            throw std::out_of_range(err);
+        }
     }
-    catch( const std::exception& e ) {
-        LOGERR("%s", e.what());
-        throw e;
+}
+
+CDBhandler::Tstate CDBhandler::get_state(const std::string& state_name) {
+    const Tstate states[] = { Tstate::ENUM_TRIG, Tstate::ENUM_RCV_ACK, Tstate::ENUM_STARTED, Tstate::ENUM_DONE, Tstate::ENUM_FAIL };
+
+    for( auto state : states ) {
+        if( state_name == get_state_name(state) ) {
+            return state;
+        }
     }
+
+    std::string err = "Not Supported state-name(" + state_name + ").";
+    throw std::out_of_range(err);
 }
 
 
 /*********************************
  * Definition of Private Function.
  */
-std::string CDBhandler::get_record_data( const Trecord& record, const std::string key ) {
+const CLayout& CDBhandler::get_layout( Ttype db_type, const std::string& table ) {
     try {
-        auto itr = record.find( key );
-        if( itr == record.end() ) {
-            std::string err = key + " is not exist in record.";
+        auto itr = _gm_layouts_.find(db_type);
+        if( itr == _gm_layouts_.end() ) {
+            std::string err = "db_type(" + std::to_string(static_cast<uint8_t>(db_type)) + ") is not exist in _gm_layouts_";
             throw std::logic_error(err);
         }
 
-        return itr->second;
+        auto itr_layout = itr->second.find(table);
+        if( itr_layout == itr->second.end() ) {
+            std::string err = "table(" + table + ") is not exist in _gm_layouts_";
+            throw std::logic_error(err);
+        }
+
+        return *(itr_layout->second);
     }
-    catch( const std::exception& e ) {
+    catch ( const std::exception& e ) {
         LOGERR("%s", e.what());
         throw e;
     }
@@ -470,53 +551,142 @@ std::shared_ptr<db_pkg::CDBsqlite>& CDBhandler::get_db_instance( Ttype db_type )
     }
 }
 
+void CDBhandler::attach_now_to_past(void) {
+    try {
+        auto& db_past = get_db_instance(Ttype::ENUM_PAST);
+
+        if( db_past->attach_database(DB_NAME_NOW, DB_SCHEMA_NOW) != SQLITE_OK ) {
+            throw std::runtime_error("Attaching NOW-DB to PAST-DB is failed.");
+        }
+
+        // Clean records that are already moved to PAST-DB, but NOW-DB was not committed.
+        // A record is matched by (uuid, msg-id), because periodic or re-issued command reuses uuid.
+        if( db_past->query_delete( context_of_clean_moved(), TVvalue() ) != SQLITE_OK ) {
+            throw std::runtime_error("Cleaning moved records in NOW-DB is failed.");
+        }
+
+        if( db_past->changes() > 0 ) {
+            LOGW("%d records in NOW-DB are already moved to PAST-DB. They are removed.", db_past->changes());
+        }
+    }
+    catch( const std::exception& e ) {
+        LOGERR("%s", e.what());
+        throw e;
+    }
+}
+
+void CDBhandler::check_query_plans(void) {
+    const std::string by_uuid = KEY_UUID " == ?";
+    struct {
+        Ttype db_type;
+        const char* verb;       // prepended by query_xxx() of IDBsqlite3.
+        std::string context;
+        TVvalue values;
+        const char* index;      // expected name of index or part of plan-detail.
+    } plans[] = {
+        // get_schedules() at start-up.
+        { Ttype::ENUM_FUTURE, "SELECT ", context_of_schedules(TABLE_EVENT), {}, INDEX_EVENT_WHEN },
+        { Ttype::ENUM_FUTURE, "SELECT ", context_of_schedules(TABLE_PERIOD), {}, INDEX_PERIOD_WHEN },
+        // dispatch_future_event() : get_records() / update_record() / remove_record() by uuid.
+        { Ttype::ENUM_FUTURE, "SELECT ", context_of_fetch(LAYOUT_FUTURE_EVENT, TABLE_EVENT, by_uuid), {Tvalue("")}, "(" KEY_UUID "=?)" },
+        { Ttype::ENUM_FUTURE, "SELECT ", context_of_fetch(LAYOUT_FUTURE_PERIOD, TABLE_PERIOD, by_uuid), {Tvalue("")}, "(" KEY_UUID "=?)" },
+        { Ttype::ENUM_FUTURE, "UPDATE ", context_of_update(TABLE_PERIOD, Tkey::ENUM_UUID, Tkey::ENUM_WHEN), {Tvalue(0.0), Tvalue("")}, "(" KEY_UUID "=?)" },
+        { Ttype::ENUM_FUTURE, "DELETE FROM ", context_of_remove(TABLE_EVENT), {Tvalue("")}, "(" KEY_UUID "=?)" },
+        // update_record() of state by msg-id.
+        { Ttype::ENUM_NOW, "UPDATE ", context_of_update(TABLE_EVENT, Tkey::ENUM_MSG_ID, Tkey::ENUM_STATE), {Tvalue(""), Tvalue(0)}, INDEX_EVENT_MSG_ID },
+        // move_record_to_past() & attach_now_to_past()
+        { Ttype::ENUM_PAST, "INSERT INTO ", context_of_move_copy(), {Tvalue(""), Tvalue(0)}, INDEX_EVENT_MSG_ID },
+        { Ttype::ENUM_PAST, "DELETE FROM ", context_of_move_remove(), {Tvalue(0)}, INDEX_EVENT_MSG_ID },
+        { Ttype::ENUM_PAST, "DELETE FROM ", context_of_clean_moved(), {}, INDEX_EVENT_UUID_MSG_ID }
+    };
+
+    for( auto& plan : plans ) {
+        std::string query = plan.verb + plan.context;
+
+        try {
+            std::string detail;
+            std::vector<std::string> details;
+            auto& db_inst = get_db_instance(plan.db_type);
+
+            if( db_inst->explain_query_plan(query, plan.values, details) != SQLITE_OK ) {
+                throw std::runtime_error("explain_query_plan is failed: " + query);
+            }
+
+            for( auto itr=details.begin(); itr!=details.end(); itr++ ) {
+                detail += (detail.empty() ? "" : " / ") + *itr;
+            }
+
+            if( detail.find(plan.index) == std::string::npos ) {
+                LOGW("Query-plan does not use index(%s): %s => %s", plan.index, query.data(), detail.data());
+            }
+            else {
+                LOGD("Query-plan: %s => %s", query.data(), detail.data());
+            }
+        }
+        catch( const std::exception& e ) {
+            // Checking query-plan is only for diagnosis, so it does not stop the service.
+            LOGERR("%s", e.what());
+        }
+    }
+}
+
+/****
+ * Contexts of hot queries. (without verb. Ex: "SELECT ", "DELETE FROM ")
+ */
+std::string CDBhandler::context_of_schedules( const std::string& table ) {
+    return KEY_UUID "," KEY_WHEN " FROM " + table + " ORDER BY " KEY_WHEN " ASC";
+}
+
+std::string CDBhandler::context_of_fetch( const CLayout& layout, const std::string& table, const std::string& condition ) {
+    return layout.columns() + " FROM " + table + " WHERE " + condition;
+}
+
+std::string CDBhandler::context_of_remove( const std::string& table ) {
+    return table + " WHERE " KEY_UUID " = ?";
+}
+
+std::string CDBhandler::context_of_update( const std::string& table, Tkey cond_key, Tkey update_key ) {
+    return table + " SET " + CRecord::get_name(update_key) + " = ? WHERE " + CRecord::get_name(cond_key) + " = ?";
+}
+
+std::string CDBhandler::context_of_move_copy(void) {
+    const std::string now_table = std::string(DB_SCHEMA_NOW) + "." TABLE_EVENT;
+    return TABLE_EVENT "(" + LAYOUT_PAST_EVENT.columns() + ") SELECT " + LAYOUT_FUTURE_EVENT.columns() 
+           + "," KEY_MSG_ID ",? FROM " + now_table + " WHERE " KEY_MSG_ID " = ?";
+}
+
+std::string CDBhandler::context_of_move_remove(void) {
+    return std::string(DB_SCHEMA_NOW) + "." TABLE_EVENT " WHERE " KEY_MSG_ID " = ?";
+}
+
+std::string CDBhandler::context_of_clean_moved(void) {
+    const std::string now_table = std::string(DB_SCHEMA_NOW) + "." TABLE_EVENT;
+    return now_table + " WHERE EXISTS (SELECT 1 FROM main." TABLE_EVENT " AS moved"
+           " WHERE moved." KEY_MSG_ID " = " + now_table + "." KEY_MSG_ID
+           " AND moved." KEY_UUID " = " + now_table + "." KEY_UUID ")";
+}
+
 void CDBhandler::regist_handlers_4_context_maker(void) {
     try {
         /* Regist Insert-Parameter-Context maker */
-        auto lamda_future_event = [this](std::shared_ptr<cmd::ICommand> cmd, std::shared_ptr<Trecord> record) -> std::string {
-            std::string context = "(" KEYS_FUTURE_EVENT ") VALUES(";
+        auto lamda_future_event = [this](std::shared_ptr<cmd::ICommand> cmd, Trecord& record, TVvalue& values) -> std::string {
             LOGD("lamda_future_event");
             try {
                 if( cmd.get() != NULL ) {
                     record = make_base_record(cmd);
                 }
 
-                if( record.get() == NULL ) {
-                    throw std::logic_error("lamda_future_event: We need record parameter.");
-                }
-
-                // check record Key-List.
-                if( record->find(KEY_UUID) == record->end() 
-                    || record->find(KEY_WHO) == record->end() 
-                    || record->find(KEY_WHEN_TEXT) == record->end() 
-                    || record->find(KEY_WHEN) == record->end() 
-                    || record->find(KEY_WHERE) == record->end() 
-                    || record->find(KEY_WHAT) == record->end() 
-                    || record->find(KEY_HOW) == record->end() 
-                    || record->find(KEY_PAYLOAD) == record->end() 
-                    ) {
-                    throw std::logic_error("lamda_future_event: There is not exist MANDATORY KEY in record.");
-                }
-
-                context = context + "'" + (*record)[KEY_UUID] + "',"  \
-                                  + "'" + (*record)[KEY_WHO] + "',"  \
-                                  + "'" + (*record)[KEY_WHEN_TEXT] + "',"  \
-                                  + (*record)[KEY_WHEN] + ","  \
-                                  + "'" + (*record)[KEY_WHERE] + "',"  \
-                                  + "'" + (*record)[KEY_WHAT] + "',"  \
-                                  + "'" + (*record)[KEY_HOW] + "',"  \
-                                  + "'" + (*record)[KEY_PAYLOAD] + "'"  \
-                                  + ")";
+                // check record Key-List & make values.
+                LAYOUT_FUTURE_EVENT.get_values(record, values);
             }
             catch( const std::exception& e ) {
                 LOGERR("%s", e.what());
                 throw e;
             }
-            return context;
+            return "(" + LAYOUT_FUTURE_EVENT.columns() + ") VALUES(" + LAYOUT_FUTURE_EVENT.params() + ")";
         };
 
-        auto lamda_future_period = [this](std::shared_ptr<cmd::ICommand> cmd, std::shared_ptr<Trecord> record) -> std::string {
-            std::string context = "(" KEYS_FUTURE_PERIOD ") VALUES(";
+        auto lamda_future_period = [this](std::shared_ptr<cmd::ICommand> cmd, Trecord& record, TVvalue& values) -> std::string {
             LOGD("lamda_future_period");
             try {
                 if( cmd.get() != NULL ) {
@@ -533,138 +703,53 @@ void CDBhandler::regist_handlers_4_context_maker(void) {
                         period *= 7;
                     }
 
-                    (*record)[KEY_PERIOD_TYPE] = period_type;
-                    (*record)[KEY_PERIOD] = std::to_string(period);
-                }
-
-                if( record.get() == NULL ) {
-                    throw std::logic_error("lamda_future_period: We need record parameter.");
+                    record.set<Tkey::ENUM_PERIOD_TYPE>( period_type );
+                    record.set<Tkey::ENUM_PERIOD>( period );
+                    record.set<Tkey::ENUM_FIRSTWHEN>( record.get<Tkey::ENUM_WHEN_TEXT>() );
                 }
 
-                // check record Key-List.
-                if( record->find(KEY_UUID) == record->end() 
-                    || record->find(KEY_WHO) == record->end() 
-                    || record->find(KEY_PERIOD_TYPE) == record->end() 
-                    || record->find(KEY_PERIOD) == record->end() 
-                    || record->find(KEY_WHEN_TEXT) == record->end() 
-                    || record->find(KEY_WHEN) == record->end() 
-                    || record->find(KEY_WHERE) == record->end() 
-                    || record->find(KEY_WHAT) == record->end() 
-                    || record->find(KEY_HOW) == record->end() 
-                    || record->find(KEY_PAYLOAD) == record->end() 
-                    ) {
-                    throw std::logic_error("lamda_future_period: There is not exist MANDATORY KEY in record.");
-                }
-
-                context = context + "'" + (*record)[KEY_UUID] + "',"  \
-                                  + "'" + (*record)[KEY_WHO] + "',"  \
-                                  + "'" + (*record)[KEY_PERIOD_TYPE] + "',"  \
-                                  + (*record)[KEY_PERIOD] + ","  \
-                                  + "'" + (*record)[KEY_WHEN_TEXT] + "',"  \
-                                  + (*record)[KEY_WHEN] + ","  \
-                                  + "'" + (*record)[KEY_WHERE] + "',"  \
-                                  + "'" + (*record)[KEY_WHAT] + "',"  \
-                                  + "'" + (*record)[KEY_HOW] + "',"  \
-                                  + "'" + (*record)[KEY_PAYLOAD] + "'"  \
-                                  + ")";
+                // check record Key-List & make values.
+                LAYOUT_FUTURE_PERIOD.get_values(record, values);
             }
             catch( const std::exception& e ) {
                 LOGERR("%s", e.what());
                 throw e;
             }
-            return context;
+            return "(" + LAYOUT_FUTURE_PERIOD.columns() + ") VALUES(" + LAYOUT_FUTURE_PERIOD.params() + ")";
         };
 
-        auto lamda_now_event = [this](std::shared_ptr<cmd::ICommand> cmd, std::shared_ptr<Trecord> record) -> std::string {
-            std::string context = "(" KEYS_NOW_EVENT ") VALUES(";
+        auto lamda_now_event = [this](std::shared_ptr<cmd::ICommand> cmd, Trecord& record, TVvalue& values) -> std::string {
             LOGD("lamda_now_event");
             try {
-                if( record.get() == NULL ) {
-                    throw std::logic_error("lamda_now_event: We need record parameter.");
-                }
-
                 if( cmd.get() != NULL ) {
                     throw std::logic_error("lamda_now_event: Not support CMD-parameter case.");
                 }
 
-                // check record Key-List.
-                if( record->find(KEY_UUID) == record->end() 
-                    || record->find(KEY_WHO) == record->end() 
-                    || record->find(KEY_WHEN_TEXT) == record->end() 
-                    || record->find(KEY_WHEN) == record->end() 
-                    || record->find(KEY_WHERE) == record->end() 
-                    || record->find(KEY_WHAT) == record->end() 
-                    || record->find(KEY_HOW) == record->end() 
-                    || record->find(KEY_PAYLOAD) == record->end() 
-                    || record->find(KEY_MSG_ID) == record->end() 
-                    || record->find(KEY_STATE) == record->end() 
-                    ) {
-                    throw std::logic_error("lamda_now_event: There is not exist MANDATORY KEY in record.");
-                }
-
-                context = context + "'" + (*record)[KEY_UUID] + "',"  \
-                                  + "'" + (*record)[KEY_WHO] + "',"  \
-                                  + "'" + (*record)[KEY_WHEN_TEXT] + "',"  \
-                                  + (*record)[KEY_WHEN] + ","  \
-                                  + "'" + (*record)[KEY_WHERE] + "',"  \
-                                  + "'" + (*record)[KEY_WHAT] + "',"  \
-                                  + "'" + (*record)[KEY_HOW] + "',"  \
-                                  + "'" + (*record)[KEY_PAYLOAD] + "',"  \
-                                  + (*record)[KEY_MSG_ID] + ","  \
-                                  + "'" + (*record)[KEY_STATE] + "'"  \
-                                  + ")";
+                // check record Key-List & make values.
+                LAYOUT_NOW_EVENT.get_values(record, values);
             }
             catch( const std::exception& e ) {
                 LOGERR("%s", e.what());
                 throw e;
             }
-            return context;
+            return "(" + LAYOUT_NOW_EVENT.columns() + ") VALUES(" + LAYOUT_NOW_EVENT.params() + ")";
         };
 
-        auto lamda_past_event = [this](std::shared_ptr<cmd::ICommand> cmd, std::shared_ptr<Trecord> record) -> std::string {
-            std::string context = "(" KEYS_PAST_EVENT ") VALUES(";
+        auto lamda_past_event = [this](std::shared_ptr<cmd::ICommand> cmd, Trecord& record, TVvalue& values) -> std::string {
             LOGD("lamda_past_event");
             try {
-                if( record.get() == NULL ) {
-                    throw std::logic_error("lamda_past_event: We need record parameter.");
-                }
-
                 if( cmd.get() != NULL ) {
                     throw std::logic_error("lamda_past_event: Not support CMD-parameter case.");
                 }
 
-                // check record Key-List.
-                if( record->find(KEY_UUID) == record->end() 
-                    || record->find(KEY_WHO) == record->end() 
-                    || record->find(KEY_WHEN_TEXT) == record->end() 
-                    || record->find(KEY_WHEN) == record->end() 
-                    || record->find(KEY_WHERE) == record->end() 
-                    || record->find(KEY_WHAT) == record->end() 
-                    || record->find(KEY_HOW) == record->end() 
-                    || record->find(KEY_PAYLOAD) == record->end() 
-                    || record->find(KEY_MSG_ID) == record->end() 
-                    || record->find(KEY_STATE) == record->end() 
-                    ) {
-                    throw std::logic_error("lamda_past_event: There is not exist MANDATORY KEY in record.");
-                }
-
-                context = context + "'" + (*record)[KEY_UUID] + "',"  \
-                                  + "'" + (*record)[KEY_WHO] + "',"  \
-                                  + "'" + (*record)[KEY_WHEN_TEXT] + "',"  \
-                                  + (*record)[KEY_WHEN] + ","  \
-                                  + "'" + (*record)[KEY_WHERE] + "',"  \
-                                  + "'" + (*record)[KEY_WHAT] + "',"  \
-                                  + "'" + (*record)[KEY_HOW] + "',"  \
-                                  + "'" + (*record)[KEY_PAYLOAD] + "',"  \
-                                  + (*record)[KEY_MSG_ID] + ","  \
-                                  + "'" + (*record)[KEY_STATE] + "'"  \
-                                  + ")";
+                // check record Key-List & make values.
+                LAYOUT_PAST_EVENT.get_values(record, values);
             }
             catch( const std::exception& e ) {
                 LOGERR("%s", e.what());
                 throw e;
             }
-            return context;
+            return "(" + LAYOUT_PAST_EVENT.columns() + ") VALUES(" + LAYOUT_PAST_EVENT.params() + ")";
         };
 
         _mm_make_context_4ins_[Ttype::ENUM_FUTURE][std::string(DB_TABLE_EVENT)] = lamda_future_event;
@@ -674,34 +759,34 @@ void CDBhandler::regist_handlers_4_context_maker(void) {
 
 
         /* Regist Condition-Context maker */
-        TCondHandler lamda_future_event_cond = [this](TFPcond& handler) -> std::string {
+        TCondHandler lamda_future_event_cond = [this](TFPcond& handler, TVvalue& values) -> std::string {
             std::map<Tkey, std::string> kopt;
             kopt[Tkey::ENUM_WHEN_TEXT] = KEY_WHEN_TEXT;
-            return handler(KEY_WHO, KEY_WHEN, KEY_WHERE, KEY_WHAT, KEY_HOW, KEY_UUID, kopt);
+            return handler(KEY_WHO, KEY_WHEN, KEY_WHERE, KEY_WHAT, KEY_HOW, KEY_UUID, kopt, values);
         };
 
-        TCondHandler lamda_future_period_cond = [this](TFPcond& handler) -> std::string {
+        TCondHandler lamda_future_period_cond = [this](TFPcond& handler, TVvalue& values) -> std::string {
             std::map<Tkey, std::string> kopt;
             kopt[Tkey::ENUM_PERIOD_TYPE] = KEY_PERIOD_TYPE;
             kopt[Tkey::ENUM_PERIOD] = KEY_PERIOD;
             kopt[Tkey::ENUM_FIRSTWHEN] = KEY_FIRSTWHEN;
-            return handler(KEY_WHO, KEY_WHEN, KEY_WHERE, KEY_WHAT, KEY_HOW, KEY_UUID, kopt);
+            return handler(KEY_WHO, KEY_WHEN, KEY_WHERE, KEY_WHAT, KEY_HOW, KEY_UUID, kopt, values);
         };
 
-        TCondHandler lamda_now_event_cond = [this](TFPcond& handler) -> std::string {
+        TCondHandler lamda_now_event_cond = [this](TFPcond& handler, TVvalue& values) -> std::string {
             std::map<Tkey, std::string> kopt;
             kopt[Tkey::ENUM_WHEN_TEXT] = KEY_WHEN_TEXT;
             kopt[Tkey::ENUM_MSG_ID] = KEY_MSG_ID;
             kopt[Tkey::ENUM_STATE] = KEY_STATE;
-            return handler(KEY_WHO, KEY_WHEN, KEY_WHERE, KEY_WHAT, KEY_HOW, KEY_UUID, kopt);
+            return handler(KEY_WHO, KEY_WHEN, KEY_WHERE, KEY_WHAT, KEY_HOW, KEY_UUID, kopt, values);
         };
 
-        TCondHandler lamda_past_event_cond = [this](TFPcond& handler) -> std::string {
+        TCondHandler lamda_past_event_cond = [this](TFPcond& handler, TVvalue& values) -> std::string {
             std::map<Tkey, std::string> kopt;
             kopt[Tkey::ENUM_WHEN_TEXT] = KEY_WHEN_TEXT;
             kopt[Tkey::ENUM_MSG_ID] = KEY_MSG_ID;
             kopt[Tkey::ENUM_STATE] = KEY_STATE;
-            return handler(KEY_WHO, KEY_WHEN, KEY_WHERE, KEY_WHAT, KEY_HOW, KEY_UUID, kopt);
+            return handler(KEY_WHO, KEY_WHEN, KEY_WHERE, KEY_WHAT, KEY_HOW, KEY_UUID, kopt, values);
         };
 
         _mm_make_context_4con_[Ttype::ENUM_FUTURE][std::string(DB_TABLE_EVENT)] = lamda_future_event_cond;
@@ -716,92 +801,18 @@ void CDBhandler::regist_handlers_4_context_maker(void) {
 }
 
 
-template std::string CDBhandler::convert_string<int8_t>( int8_t value );
-template std::string CDBhandler::convert_string<int16_t>( int16_t value );
-template std::string CDBhandler::convert_string<int32_t>( int32_t value );
-template std::string CDBhandler::convert_string<uint8_t>( uint8_t value );
-template std::string CDBhandler::convert_string<uint16_t>( uint16_t value );
-template std::string CDBhandler::convert_string<uint32_t>( uint32_t value );
-template std::string CDBhandler::convert_string<double>( double value );
-template std::string CDBhandler::convert_string<float>( float value );
-
-template<>
-std::string CDBhandler::convert_string(std::string value) {
-    return value;
-}
-
-template<>
-std::string CDBhandler::convert_string(Tstate value) {
-    switch( value ) {
-    case Tstate::ENUM_TRIG:
-        return "TRIGGERED";
-    case Tstate::ENUM_RCV_ACK:
-        return "RCV_ACK";
-    case Tstate::ENUM_STARTED:
-        return "STARTED";
-    case Tstate::ENUM_DONE:
-        return "DONE";
-    case Tstate::ENUM_FAIL:
-        return "FAIL";
-    default:
-        {
-            std::string err = "Not Supported Tstate(" + std::to_string(static_cast<uint32_t>(value)) + ").";
-            throw std::out_of_range(err);
-        }
-    }
-}
-
-template<typename T>
-std::string CDBhandler::convert_string(T value) {
-    return std::to_string(value);
-}
-
-std::string CDBhandler::get_value_context(Tkey key, std::string& value) {
-    try {
-        switch( key ) {
-        case Tkey::ENUM_ID:
-        case Tkey::ENUM_MSG_ID:
-        case Tkey::ENUM_PERIOD:
-        case Tkey::ENUM_WHEN:
-            return value;
-        case Tkey::ENUM_UUID:
-        case Tkey::ENUM_FIRSTWHEN:
-        case Tkey::ENUM_HOW:
-        case Tkey::ENUM_PAYLOAD:
-        case Tkey::ENUM_PERIOD_TYPE:
-        case Tkey::ENUM_STATE:
-        case Tkey::ENUM_WHAT:
-        case Tkey::ENUM_WHEN_TEXT:
-        case Tkey::ENUM_WHERE:
-        case Tkey::ENUM_WHO:
-            return "'" + value + "'";
-        default:
-            {
-                std::string err = "Not Supported key(" + std::to_string(static_cast<uint16_t>(key)) + ")";
-                throw std::out_of_range(err);
-            }
-        }
-    }
-    catch ( const std::exception& e ) {
-        LOGERR("%s", e.what());
-        throw e;
-    }
-}
-
 void CDBhandler::update_record_raw(Ttype db_type, const char* table_name, 
-                                   Tkey cond_key, std::string& cond_val, 
-                                   Tkey target_key, std::string& target_val) {
+                                   Tkey cond_key, Tvalue& cond_val, 
+                                   Tkey target_key, Tvalue& target_val) {
     try {
         std::string table;
         std::string context;
-        std::string key_cond;
-        std::string key_tar;
 
         if( table_name == NULL ) {
             throw std::invalid_argument("Table Name is NULL.");
         }
 
-        if( cond_val.empty() == true ) {
+        if( cond_val.type() == Tvalue::Ttype::ENUM_NULL ) {
             throw std::invalid_argument("Condition-value is NULL");
         }
 
@@ -809,12 +820,10 @@ void CDBhandler::update_record_raw(Ttype db_type, const char* table_name,
         auto& db_inst = get_db_instance(db_type);
 
         // make context
-        key_cond = _gm_key_names_all_.find(cond_key)->second;
-        key_tar = _gm_key_names_all_.find(target_key)->second;
-        context = table + " SET " + key_tar + " = " + target_val + " WHERE " + key_cond + " = " + cond_val;
+        context = context_of_update( table, cond_key, target_key );
         
         // query context
-        if( db_inst->query_update( context ) != SQLITE_OK ) {
+        if( db_inst->query_update( context, {target_val, cond_val} ) != SQLITE_OK ) {
             std::string err = "query_update is failed. (UPDATE " + context + ")";
             throw std::runtime_error(err);
         }
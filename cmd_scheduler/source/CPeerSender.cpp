@@ -0,0 +1,158 @@
+#include <CPeerSender.h>
+#include <time_kes.h>
+
+#include <logger.h>
+
+namespace service {
+
+
+constexpr size_t CPeerSender::DEFAULT_WORKER_CNT;
+
+
+/*********************************
+ * Definition of Public Function.
+ */
+CPeerSender::CPeerSender( size_t worker_cnt )
+: _m_worker_cnt_(worker_cnt), _m_is_continue_(false) {
+    if( _m_worker_cnt_ == 0 ) {
+        throw std::invalid_argument("worker_cnt is 0.");
+    }
+}
+
+CPeerSender::~CPeerSender( void ) {
+    stop();
+}
+
+void CPeerSender::start( void ) {
+    try {
+        std::lock_guard<std::mutex> guard(_mtx_strands_);
+        if( _m_is_continue_ == true ) {
+            throw std::logic_error("Already, workers are started.");
+        }
+
+        _m_is_continue_ = true;
+        for( size_t i=0; i < _m_worker_cnt_; i++ ) {
+            _mv_workers_.push_back( std::thread(&CPeerSender::handle_jobs, this) );
+        }
+        LOGI("Peer-Sender workers(%zu) are started.", _m_worker_cnt_);
+    }
+    catch( const std::exception& e ) {
+        LOGERR("%s", e.what());
+        throw e;
+    }
+}
+
+void CPeerSender::stop( void ) {
+    {
+        std::lock_guard<std::mutex> guard(_mtx_strands_);
+        _m_is_continue_ = false;
+    }
+    _m_cv_.notify_all();
+
+    for( auto itr=_mv_workers_.begin(); itr!=_mv_workers_.end(); itr++ ) {
+        if( itr->joinable() == true ) {
+            itr->join();
+        }
+    }
+    _mv_workers_.clear();
+}
+
+void CPeerSender::post( const std::string& peer, TJob job ) {
+    {
+        std::lock_guard<std::mutex> guard(_mtx_strands_);
+        CStrand& strand = _mm_strands_[peer];
+
+        strand.jobs.push_back( std::make_pair(time_pkg::CTime::get<double>(), std::move(job)) );
+        strand.counter.depth = strand.jobs.size();
+        if( strand.counter.depth > strand.counter.depth_max ) {
+            strand.counter.depth_max = strand.counter.depth;
+        }
+
+        // If another worker is running jobs of this peer, then it will run this job too.
+        if( strand.is_scheduled == true ) {
+            return ;
+        }
+
+        strand.is_scheduled = true;
+        _mv_ready_.push( peer );
+    }
+    _m_cv_.notify_one();
+}
+
+CPeerSender::TMcounter CPeerSender::get_counters( void ) {
+    TMcounter counters;
+    std::lock_guard<std::mutex> guard(_mtx_strands_);
+
+    for( auto itr=_mm_strands_.begin(); itr!=_mm_strands_.end(); itr++ ) {
+        counters[itr->first] = itr->second.counter;
+    }
+    return counters;
+}
+
+void CPeerSender::print_counters( void ) {
+    auto counters = get_counters();
+
+    for( auto itr=counters.begin(); itr!=counters.end(); itr++ ) {
+        const CCounter& cnt = itr->second;
+        LOGI("peer(%s): depth=%zu, depth-max=%zu, done=%llu, latency-avg=%f, latency-max=%f", 
+             itr->first.data(), cnt.depth, cnt.depth_max, (unsigned long long)cnt.done, cnt.latency_avg(), cnt.latency_max);
+    }
+}
+
+
+/*********************************
+ * Definition of Private Function.
+ */
+int CPeerSender::handle_jobs( void ) {
+    std::unique_lock<std::mutex> lk(_mtx_strands_);
+
+    while( true ) {
+        _m_cv_.wait(lk, [&]() {
+            return ((false == _mv_ready_.empty()) || (false == _m_is_continue_));
+        });
+
+        // Exit after all of posted jobs are executed.
+        if( _mv_ready_.empty() == true ) {
+            break;
+        }
+
+        std::string peer = _mv_ready_.front();
+        _mv_ready_.pop();
+
+        CStrand& strand = _mm_strands_[peer];      // element of std::map is not moved by insertion.
+        auto job = std::move( strand.jobs.front() );
+        strand.jobs.pop_front();
+        strand.counter.depth = strand.jobs.size();
+
+        lk.unlock();
+        try {
+            job.second();
+        }
+        catch( const std::exception& e ) {
+            LOGERR("peer(%s): %s", peer.data(), e.what());
+        }
+        double latency = time_pkg::CTime::get<double>() - job.first;
+        lk.lock();
+
+        strand.counter.done++;
+        strand.counter.latency_sum += latency;
+        if( latency > strand.counter.latency_max ) {
+            strand.counter.latency_max = latency;
+        }
+
+        // Next job of this peer is run by any worker. (It keeps order of peer, and fairness between peers.)
+        if( strand.jobs.empty() == false ) {
+            _mv_ready_.push( peer );
+            _m_cv_.notify_one();
+        }
+        else {
+            strand.is_scheduled = false;
+        }
+    }
+
+    LOGI("Exit Peer-Sender worker.");
+    return 0;
+}
+
+
+}   // namespace service
@@ -0,0 +1,100 @@
+#include <CPendingTable.h>
+
+#include <logger.h>
+
+namespace service {
+
+
+/*********************************
+ * Definition of Public Function.
+ */
+CPendingTable::CPendingTable( void )
+: _m_msg_ids_( cmd::CMsgIdAllocator::get_instance() ) {
+    // allocator is created before this table, so it's alive until this table is destroyed.
+}
+
+CPendingTable::~CPendingTable( void ) {
+    clear();
+}
+
+bool CPendingTable::insert( uint32_t msg_id, const Tdb::Trecord& record, Tdb::Tstate state, double costtime ) {
+    std::lock_guard<std::mutex> guard(_mtx_pending_);
+    auto result = _mm_pending_.emplace( msg_id, CPending() );
+
+    if( result.second == false ) {
+        LOGW("msg-id(%u) is already exist in pending-table.", msg_id);
+        return false;
+    }
+
+    CPending& pending = result.first->second;
+    pending.record = record;
+    pending.state = state;
+    pending.costtime = costtime;
+    _m_msg_ids_.reserve( msg_id );
+    return true;
+}
+
+bool CPendingTable::update( uint32_t msg_id, Tdb::Tstate state, const TFvisit& on_updated ) {
+    std::lock_guard<std::mutex> guard(_mtx_pending_);
+    auto itr = _mm_pending_.find(msg_id);
+    if( itr == _mm_pending_.end() || itr->second.state >= state ) {
+        return false;
+    }
+
+    itr->second.state = state;
+    if( on_updated != nullptr ) {
+        on_updated( itr->second );
+    }
+    return true;
+}
+
+bool CPendingTable::remove( uint32_t msg_id ) {
+    std::lock_guard<std::mutex> guard(_mtx_pending_);
+    auto itr = _mm_pending_.find(msg_id);
+    if( itr == _mm_pending_.end() ) {
+        return false;
+    }
+
+    _mm_pending_.erase(itr);
+    _m_msg_ids_.release( msg_id );
+    return true;
+}
+
+bool CPendingTable::expire( uint32_t msg_id, Tdb::Tstate state ) {
+    std::lock_guard<std::mutex> guard(_mtx_pending_);
+    auto itr = _mm_pending_.find(msg_id);
+    if( itr == _mm_pending_.end() || itr->second.state != state ) {
+        return false;
+    }
+
+    _mm_pending_.erase(itr);
+    _m_msg_ids_.release( msg_id );
+    return true;
+}
+
+bool CPendingTable::visit( uint32_t msg_id, const TFvisit& func ) {
+    std::lock_guard<std::mutex> guard(_mtx_pending_);
+    auto itr = _mm_pending_.find(msg_id);
+    if( itr == _mm_pending_.end() ) {
+        return false;
+    }
+
+    func( itr->second );
+    return true;
+}
+
+size_t CPendingTable::size( void ) {
+    std::lock_guard<std::mutex> guard(_mtx_pending_);
+    return _mm_pending_.size();
+}
+
+void CPendingTable::clear( void ) {
+    std::lock_guard<std::mutex> guard(_mtx_pending_);
+    for( auto itr=_mm_pending_.begin(); itr!=_mm_pending_.end(); itr++ ) {
+        _m_msg_ids_.release( itr->first );
+    }
+    _mm_pending_.clear();
+}
+
+
+}   // namespace service
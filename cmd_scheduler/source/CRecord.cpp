@@ -0,0 +1,173 @@
+#include <CRecord.h>
+
+#include <logger.h>
+
+namespace db {
+
+
+constexpr size_t CRecord::COLUMN_CNT;
+
+namespace {
+
+/** Sequence of column-index for generating tables at compile-time. */
+template <size_t... I> struct TIndexes {};
+template <size_t N, size_t... I> struct TMakeIndexes : TMakeIndexes<N-1, N-1, I...> {};
+template <size_t... I> struct TMakeIndexes<0, I...> { using type = TIndexes<I...>; };
+
+using TFPvalue = CRecord::Tvalue (*)( const CRecord& record );
+using TFPcolumn = void (*)( CRecord& record, const CRecord::Tstatement& stmt, int col );
+
+void read_column( const CRecord::Tstatement& stmt, int col, int64_t& out ) {
+    out = stmt.column_integer(col);
+}
+
+void read_column( const CRecord::Tstatement& stmt, int col, double& out ) {
+    out = stmt.column_real(col);
+}
+
+void read_column( const CRecord::Tstatement& stmt, int col, std::string& out ) {
+    out = stmt.column_text(col);
+}
+
+template <size_t I>
+CRecord::Tvalue value_of( const CRecord& record ) {
+    return CRecord::Tvalue( record.get<static_cast<Tkey>(I+1)>() );
+}
+
+template <size_t I>
+void column_of( CRecord& record, const CRecord::Tstatement& stmt, int col ) {
+    CRecord::Ttype<static_cast<Tkey>(I+1)> value;
+    read_column( stmt, col, value );
+    record.set<static_cast<Tkey>(I+1)>( std::move(value) );
+}
+
+template <size_t... I>
+const TFPvalue* make_value_table( TIndexes<I...> ) {
+    static const TFPvalue table[] = { &value_of<I>... };
+    return table;
+}
+
+template <size_t... I>
+const TFPcolumn* make_column_table( TIndexes<I...> ) {
+    static const TFPcolumn table[] = { &column_of<I>... };
+    return table;
+}
+
+using TColumnIndexes = TMakeIndexes<CRecord::COLUMN_CNT>::type;
+
+const char* const COLUMN_NAMES[CRecord::COLUMN_CNT] = {
+    KEY_MSG_ID,
+    KEY_STATE,
+    KEY_PERIOD,
+    KEY_PERIOD_TYPE,
+    KEY_FIRSTWHEN,
+    KEY_WHEN_TEXT,
+    KEY_ID,
+    KEY_UUID,
+    KEY_WHO,
+    KEY_WHEN,
+    KEY_WHERE,
+    KEY_WHAT,
+    KEY_HOW,
+    KEY_PAYLOAD
+};
+
+inline void check_key( Tkey key ) {
+    if( key_index(key) >= CRecord::COLUMN_CNT ) {
+        std::string err = "Not Supported key(" + std::to_string(static_cast<uint16_t>(key)) + ")";
+        throw std::out_of_range(err);
+    }
+}
+
+}   // namespace
+
+
+/*********************************
+ * Definition of CRecord Function.
+ */
+CRecord::Tvalue CRecord::get_value( Tkey key ) const {
+    static const TFPvalue* table = make_value_table( TColumnIndexes() );
+
+    try {
+        check_key(key);
+        return table[ key_index(key) ]( *this );
+    }
+    catch( const std::exception& e ) {
+        LOGERR("%s", e.what());
+        throw e;
+    }
+}
+
+void CRecord::set_column( Tkey key, const Tstatement& stmt, int col ) {
+    static const TFPcolumn* table = make_column_table( TColumnIndexes() );
+
+    try {
+        check_key(key);
+        table[ key_index(key) ]( *this, stmt, col );
+    }
+    catch( const std::exception& e ) {
+        LOGERR("%s", e.what());
+        throw e;
+    }
+}
+
+const char* CRecord::get_name( Tkey key ) {
+    check_key(key);
+    return COLUMN_NAMES[ key_index(key) ];
+}
+
+
+/*********************************
+ * Definition of CLayout Function.
+ */
+CLayout::CLayout( std::initializer_list<Tkey> keys )
+: _mv_keys_(keys), _m_mask_(0) {
+    for( auto itr=_mv_keys_.begin(); itr!=_mv_keys_.end(); itr++ ) {
+        if( _m_columns_.empty() == false ) {
+            _m_columns_ += ",";
+            _m_params_ += ",";
+        }
+
+        _m_columns_ += CRecord::get_name(*itr);
+        _m_params_ += "?";
+        _m_mask_ |= key_bit(*itr);
+    }
+}
+
+void CLayout::get_values( const CRecord& record, db_pkg::IDBsqlite3::TVvalue& values ) const {
+    try {
+        if( record.has_all(_m_mask_) == false ) {
+            std::string err = "There is not exist MANDATORY KEY in record. (columns: " + _m_columns_ + ")";
+            throw std::logic_error(err);
+        }
+
+        values.reserve( values.size() + _mv_keys_.size() );
+        for( auto itr=_mv_keys_.begin(); itr!=_mv_keys_.end(); itr++ ) {
+            values.push_back( record.get_value(*itr) );
+        }
+    }
+    catch( const std::exception& e ) {
+        LOGERR("%s", e.what());
+        throw e;
+    }
+}
+
+void CLayout::load( CRecord& record, const CRecord::Tstatement& stmt ) const {
+    try {
+        if( stmt.column_count() != static_cast<int>(_mv_keys_.size()) ) {
+            std::string err = "column count(" + std::to_string(stmt.column_count()) + ") is not matched with layout(" + _m_columns_ + ").";
+            throw std::logic_error(err);
+        }
+
+        for( int col=0; col < static_cast<int>(_mv_keys_.size()); col++ ) {
+            record.set_column( _mv_keys_[col], stmt, col );
+        }
+    }
+    catch( const std::exception& e ) {
+        LOGERR("%s", e.what());
+        throw e;
+    }
+}
+
+
+}   // namespace db
@@ -0,0 +1,60 @@
+#include <cmath>
+#include <algorithm>
+
+#include <CRetryEngine.h>
+
+#include <logger.h>
+
+namespace service {
+
+
+constexpr double CRetryEngine::TIMEOUT_ACK;
+constexpr double CRetryEngine::TIMEOUT_ACK_MAX;
+constexpr double CRetryEngine::BACKOFF_FACTOR;
+constexpr uint32_t CRetryEngine::MAX_RETRY;
+constexpr double CRetryEngine::SLACK_START;
+constexpr double CRetryEngine::SLACK_DONE;
+
+
+/*********************************
+ * Definition of Public Function.
+ */
+void CRetryEngine::arm_ack( uint32_t msg_id, uint32_t attempt ) {
+    double timeout = std::min( TIMEOUT_ACK * std::pow(BACKOFF_FACTOR, attempt), TIMEOUT_ACK_MAX );
+
+    LOGD("msg-id(%u): wait ACK for %f seconds. (attempt=%u)", msg_id, timeout, attempt);
+    _m_timer_.push( msg_id, Ttimer::now() + timeout, CRetry(Tstate::ENUM_TRIG, attempt) );
+}
+
+void CRetryEngine::arm_start( uint32_t msg_id, double when ) {
+    double deadline = std::max( Ttimer::now(), when ) + SLACK_START;
+
+    LOGD("msg-id(%u): wait ACT-START until %f.", msg_id, deadline);
+    _m_timer_.push( msg_id, deadline, CRetry(Tstate::ENUM_RCV_ACK) );
+}
+
+void CRetryEngine::arm_done( uint32_t msg_id, double costtime ) {
+    double deadline = Ttimer::now() + std::max( costtime, 0.0 ) + SLACK_DONE;
+
+    LOGD("msg-id(%u): wait RESP until %f.", msg_id, deadline);
+    _m_timer_.push( msg_id, deadline, CRetry(Tstate::ENUM_STARTED) );
+}
+
+bool CRetryEngine::disarm( uint32_t msg_id ) {
+    return _m_timer_.remove( msg_id );
+}
+
+bool CRetryEngine::wait_expired( TVexpired& expired ) {
+    return _m_timer_.wait_pop( expired );
+}
+
+size_t CRetryEngine::size( void ) {
+    return _m_timer_.size();
+}
+
+void CRetryEngine::stop( void ) {
+    _m_timer_.stop();
+}
+
+
+}   // namespace service
@@ -12,6 +12,12 @@ const std::string CScheduler::APP_PATH = "CMD-Scheduler";
 const std::string CScheduler::PVD_COMMANDER = "cmd_transceiver";
 const std::string CScheduler::PVD_DEBUGGER = "def_debugger";
 
+constexpr double CScheduler::TIME_DISPATCH_LEAD;
+constexpr size_t CScheduler::RX_QUEUE_SIZE;
+constexpr size_t CScheduler::DEFAULT_RX_WORKERS;
+constexpr size_t CScheduler::MAX_RX_WORKERS;
+constexpr const char* CScheduler::ENV_RX_WORKERS;
+
 
 /*********************************
  * Definition of Public Function.
@@ -47,6 +53,8 @@ void CScheduler::start( void ) {
         throw std::runtime_error("MCommunicator is NULL.");
     }
 
+    load_future_events();
+    load_pending_commands();
     create_threads();
     _m_comm_mng_->start();
 }
@@ -67,19 +75,52 @@ CScheduler::~CScheduler(void) {
  * Definition of Private Function.
  */
 CScheduler::CScheduler( void ) {
+    size_t workers = get_rx_worker_count();
+
+    // Create RX-queue per shard.
+    for( size_t i=0; i < workers; i++ ) {
+        _mv_cmds_.push_back( std::make_shared<TCMDqueue>(RX_QUEUE_SIZE) );
+    }
     clear();
 }
 
 void CScheduler::clear( void ) {
     _m_comm_mng_.reset();
     _m_is_continue_ = false;
+    _m_pending_.clear();
 
     {
-        std::unique_lock<std::mutex> lk(_mtx_queue_lock_);
-        while( _mv_cmds_.empty() == false ) {
-            _mv_cmds_.pop();
+        std::unique_lock<std::mutex> lk(_mtx_db_jobs_);
+        _m_is_db_writing_ = false;
+        while( _mv_db_jobs_.empty() == false ) {
+            _mv_db_jobs_.pop();
+        }
+    }
+
+    for( auto itr=_mv_cmds_.begin(); itr!=_mv_cmds_.end(); itr++ ) {
+        std::shared_ptr<cmd::ICommand> cmd;
+        while( (*itr)->try_pop( cmd ) == true ) {
+            cmd.reset();
+        }
+    }
+}
+
+size_t CScheduler::get_rx_worker_count( void ) {
+    size_t workers = DEFAULT_RX_WORKERS;
+    const char* value = getenv(ENV_RX_WORKERS);
+
+    if( value != NULL ) {
+        long count = strtol(value, NULL, 10);
+        if( count <= 0 || count > static_cast<long>(MAX_RX_WORKERS) ) {
+            LOGW("%s(%s) is invalid. (valid range: 1 ~ %zu)", ENV_RX_WORKERS, value, MAX_RX_WORKERS);
+        }
+        else {
+            workers = static_cast<size_t>(count);
         }
     }
+
+    LOGI("RX-workers = %zu", workers);
+    return workers;
 }
 
 void CScheduler::receive_command( std::shared_ptr<cmd::ICommand>& cmd ) {
@@ -103,10 +144,10 @@ void CScheduler::receive_command( std::shared_ptr<cmd::ICommand>& cmd ) {
 }
 
 void CScheduler::send_command( const std::string& peer_app, const std::string& peer_pvd, 
-                               std::shared_ptr<Tdb::Trecord>& record ) {
+                               Tdb::Trecord& record, double costtime ) {
     try {
         alias::CAlias peer(peer_app, peer_pvd);
-        send_command( peer, record );
+        send_command( peer, record, costtime );
     }
     catch ( const std::exception& e ) {
         LOGERR("%s", e.what());
@@ -114,32 +155,53 @@ void CScheduler::send_command( const std::string& peer_app, const std::string& p
     }
 }
 
-void CScheduler::send_command( alias::CAlias& peer, std::shared_ptr<Tdb::Trecord>& record ) {
+/** Record is loaded from DB, so costtime is extracted from its payload. */
+void CScheduler::send_command( alias::CAlias& peer, Tdb::Trecord& record ) {
+    send_command( peer, record, get_costtime(Tdb::get_payload(record)) );
+}
+
+void CScheduler::send_command( alias::CAlias& peer, Tdb::Trecord& record, double costtime ) {
     try {
         uint32_t msg_id = 0;
-        Tdb::Tstate state = Tdb::Tstate::ENUM_FAIL;
-        Tdb::Ttype db_type = Tdb::Ttype::ENUM_PAST;
-        std::string payload = Tdb::get_payload(*record);
+        const std::string& payload = Tdb::get_payload(record);
         LOGI("Send request message to peer(%s/%s).", peer.app_path.data(), peer.pvd_id.data());
 
-        // we need lock for NOW-DB consistency-timing.
-        std::lock_guard<std::mutex> locker(_mtx_send_lock_);
+        // Register the CMD to pending-table with state == TRIGGERED before sending,
+        // because ACK of peer can be received before request() is returned.
+        record.set<Tdb::Tkey::ENUM_STATE>( Tdb::get_state_name(Tdb::Tstate::ENUM_TRIG) );
+        do {
+            msg_id = cmd::CuCMD::gen_msg_id();
+            record.set<Tdb::Tkey::ENUM_MSG_ID>( msg_id );
+        } while( _m_pending_.insert(msg_id, record, Tdb::Tstate::ENUM_TRIG, costtime) == false );
 
-        // Trig peer to do activity according to a json-data. (send json-data to peer)
-        //      We will get msg-id from MCommunicator->request()
-        msg_id = _m_comm_mng_->request( peer, payload, common::E_STATE::E_STATE_THR_CMD );
-        LOGD("TX-MSG: msg-id=%u", msg_id);
+        push_db_job( [this, record]() mutable -> void {
+            _m_db_.insert_record(Tdb::Ttype::ENUM_NOW, Tdb::DB_TABLE_EVENT, record);
+        });
+        _m_retry_.arm_ack(msg_id, 0);
 
-        // If get msg-id != 0, then append record to DataBase(Now-DB) with state == TRIGGERED & msg-id.
-        // But msg-id == 0, then append record to DataBase(PAST-DB) with state == FAIL & msg-id.
-        if( msg_id != 0 ) {
-            state = Tdb::Tstate::ENUM_TRIG;
-            db_type = Tdb::Ttype::ENUM_NOW;
-        }
+        // Trig peer to do activity according to a json-data. (send json-data to peer)
+        post_request( peer, payload, msg_id );
+    }
+    catch ( const std::exception& e ) {
+        LOGERR("%s", e.what());
+        throw e;
+    }
+}
 
-        _m_db_.append(record, Tdb::Tkey::ENUM_MSG_ID, msg_id);
-        _m_db_.append(record, Tdb::Tkey::ENUM_STATE, state);
-        _m_db_.insert_record(db_type, Tdb::DB_TABLE_EVENT, record);
+void CScheduler::post_request( const alias::CAlias& peer, const std::string& payload, uint32_t msg_id ) {
+    try {
+        std::string peer_key = peer.app_path + "/" + peer.pvd_id;
+
+        // Request is sent by send-queue of the peer, so slow peer does not block other peers.
+        _m_sender_.post( peer_key, [this, peer, payload, msg_id]() -> void {
+            // If sending is failed, then MCommunicator->request() return msg-id == 0.
+            // But, it's re-sent by Retry-Engine until the ACK-timeout is exhausted.
+            if( _m_comm_mng_->request( peer, payload, common::E_STATE::E_STATE_THR_CMD, true, msg_id ) == 0 ) {
+                LOGW("Sending of TX-MSG(msg-id=%u) is failed. It will be retried.", msg_id);
+                return ;
+            }
+            LOGD("TX-MSG: msg-id=%u", msg_id);
+        });
     }
     catch ( const std::exception& e ) {
         LOGERR("%s", e.what());
@@ -147,18 +209,23 @@ void CScheduler::send_command( alias::CAlias& peer, std::shared_ptr<Tdb::Trecord
     }
 }
 
-/** Push function for Blocking queue. */
+/** Push function for Blocking queue. (Lock-free: It's called by threads of communicators.) */
 void CScheduler::push_cmd( std::shared_ptr<cmd::ICommand>& cmd ) {
     try {
-        std::unique_lock<std::mutex> lk(_mtx_queue_lock_);
-
         if (false == _m_is_continue_.load()) {
             std::string err = "Thread termination is occured.";
             throw std::out_of_range(err);
         }
 
-        _mv_cmds_.emplace( cmd );
-        _m_queue_cv_.notify_all();
+        // CMDs of a peer are pushed to same shard, so they are processed in order.
+        const alias::CAlias& from = cmd->get_from();
+        size_t shard = std::hash<std::string>()(from.app_path + "/" + from.pvd_id) % _mv_cmds_.size();
+
+        if( _mv_cmds_[shard]->push( cmd ) == false ) {
+            std::string err = "CMDs-queue[" + std::to_string(shard) + "] is full. (depth=" 
+                            + std::to_string(_mv_cmds_[shard]->depth()) + ") CMD is dropped.";
+            throw std::out_of_range(err);
+        }
     }
     catch ( const std::out_of_range& e ) {
         LOGW("%s", e.what());
@@ -170,29 +237,13 @@ void CScheduler::push_cmd( std::shared_ptr<cmd::ICommand>& cmd ) {
 }
 
 /** Pop function for Blocking queue. */
-std::shared_ptr<cmd::ICommand> CScheduler::pop_cmd( void ) {    // Blocking 
+std::shared_ptr<cmd::ICommand> CScheduler::pop_cmd( size_t shard ) {    // Blocking 
     std::shared_ptr<cmd::ICommand> cmd;
     try {
-        std::unique_lock<std::mutex> lk(_mtx_queue_lock_);
-
-        if ( (true == _mv_cmds_.empty()) && (true == _m_is_continue_.load()) ) {
-            _m_queue_cv_.wait(lk, [&]() {
-                return ((false == _mv_cmds_.empty()) || (false == _m_is_continue_.load()));
-            });
-        }
-
-        if (false == _m_is_continue_.load()) {
+        if ( (false == _mv_cmds_[shard]->wait_pop( cmd )) || (false == _m_is_continue_.load()) ) {
             std::string err = "Thread termination is occured.";
             throw std::out_of_range(err);
         }
-
-        if( _mv_cmds_.empty() == true ) {
-            std::string err = "CMDs-queue is empty.";
-            throw std::logic_error(err);
-        }
-
-        cmd = _mv_cmds_.front();
-        _mv_cmds_.pop();
     }
     catch ( const std::out_of_range& e ) {
         LOGW("%s", e.what());
@@ -252,25 +303,278 @@ double CScheduler::convert_json_to_event( std::string& payload, double& next_whe
     return when;
 }
 
+/****
+ * Dispatch-Timer related functions
+ */
+void CScheduler::load_future_events( void ) {
+    try {
+        _m_db_.get_schedules(Tdb::Ttype::ENUM_FUTURE, Tdb::DB_TABLE_EVENT, [this](const std::string& uuid, double when) -> void {
+            schedule_future_event(Tdb::DB_TABLE_EVENT, uuid, when);
+        });
+        _m_db_.get_schedules(Tdb::Ttype::ENUM_FUTURE, Tdb::DB_TABLE_PERIOD, [this](const std::string& uuid, double when) -> void {
+            schedule_future_event(Tdb::DB_TABLE_PERIOD, uuid, when);
+        });
+        LOGI("Future-events(%zu) are loaded to dispatch-timer.", _m_timer_.size());
+    }
+    catch ( const std::exception& e ) {
+        LOGERR("%s", e.what());
+        throw e;
+    }
+}
+
+void CScheduler::schedule_future_event( const char* table_name, const std::string& uuid, double when ) {
+    // If this event is earlier than others, then TX-thread wakes up by it.
+    _m_timer_.push( TtimerKey(table_name, uuid), when - TIME_DISPATCH_LEAD, when );
+}
+
+void CScheduler::dispatch_future_event( const std::string& table, const std::string& uuid ) {
+    try {
+        Tdb& db_ref = _m_db_;
+        bool is_period = (table == Tdb::DB_TABLE_PERIOD);
+        Tdb::TFPcond lamda_make_condition = [&uuid](std::string kwho, std::string kwhen, 
+                                                    std::string kwhere, std::string kwhat, 
+                                                    std::string khow, std::string kuuid,
+                                                    std::map<Tdb::Tkey, std::string>& kopt,
+                                                    Tdb::TVvalue& values) -> std::string {
+            // Load a record from DataBase(Future-DB) that is matched with uuid.
+            values.push_back( Tdb::Tvalue(uuid) );
+            return (kuuid + " == ?");
+        };
+        Tdb::TFPconvert lamda_convertor = [&](Tdb::Ttype db_type, Tdb::Trecord& record, std::string& payload) -> void {
+            // When we load json-data from PeriodBase tables, We must convert "period when" to "specific when".
+            double when = 0.0;
+            double next_when = 0.0;
+            std::string legacy_uuid = db_ref.get_uuid(record);
+
+            when = convert_json_to_event( payload, next_when );
+            db_ref.convert_record_to_event(db_type, record, when);
+            db_ref.update_record(db_type, Tdb::DB_TABLE_PERIOD, 
+                                 Tdb::Tkey::ENUM_UUID, legacy_uuid, 
+                                 Tdb::Tkey::ENUM_WHEN, next_when);
+            schedule_future_event(Tdb::DB_TABLE_PERIOD, legacy_uuid, next_when);
+        };
+
+        auto records = _m_db_.get_records(Tdb::Ttype::ENUM_FUTURE, table.c_str(), lamda_make_condition, 
+                                          (is_period ? lamda_convertor : nullptr) );
+        if( records->size() == 0 ) {
+            std::string warn = "Record(uuid: " + uuid + ") is not exist in " + table + " of Future-DB.";
+            throw std::out_of_range(warn);
+        }
+
+        // send command-msg to peer.
+        for( auto itr=records->begin(); itr!=records->end(); itr++ ) {
+            Tdb::Trecord& record = *itr;
+            auto peer = Tdb::get_who(record);
+
+            send_command(*peer, record);
+        }
+
+        // remove one-time event from Future-DB.
+        if( is_period == false ) {
+            _m_db_.remove_record(Tdb::Ttype::ENUM_FUTURE, Tdb::DB_TABLE_EVENT, uuid);
+        }
+    }
+    catch ( const std::out_of_range& e ) {
+        LOGW("%s", e.what());
+    }
+    catch ( const std::exception& e ) {
+        LOGERR("%s", e.what());
+        throw e;
+    }
+}
+
+/****
+ * Pending-Table related functions
+ */
+void CScheduler::load_pending_commands( void ) {
+    try {
+        Tdb::TFPcond lamda_make_condition = [](std::string /*kwho*/, std::string /*kwhen*/, 
+                                               std::string /*kwhere*/, std::string /*kwhat*/, 
+                                               std::string /*khow*/, std::string /*kuuid*/,
+                                               std::map<Tdb::Tkey, std::string>& kopt,
+                                               Tdb::TVvalue& /*values*/) -> std::string {
+            // Load all of in-flight CMDs from DataBase(NOW-DB).
+            return (kopt[Tdb::Tkey::ENUM_MSG_ID] + " != 0");
+        };
+
+        auto records = _m_db_.get_records(Tdb::Ttype::ENUM_NOW, Tdb::DB_TABLE_EVENT, lamda_make_condition, nullptr);
+        for( auto itr=records->begin(); itr!=records->end(); itr++ ) {
+            uint32_t msg_id = static_cast<uint32_t>( itr->get<Tdb::Tkey::ENUM_MSG_ID>() );
+            Tdb::Tstate state = Tdb::get_state( itr->get<Tdb::Tkey::ENUM_STATE>() );
+
+            double costtime = get_costtime( Tdb::get_payload(*itr) );
+
+            if( _m_pending_.insert(msg_id, *itr, state, costtime) == true ) {
+                _m_pending_.visit(msg_id, [this, msg_id](const CPendingTable::CPending& pending) -> void {
+                    arm_retry(msg_id, pending);
+                });
+            }
+        }
+        LOGI("In-flight CMDs(%zu) are loaded to pending-table.", _m_pending_.size());
+    }
+    catch ( const std::exception& e ) {
+        LOGERR("%s", e.what());
+        throw e;
+    }
+}
+
+void CScheduler::push_db_job( TdbJob job ) {
+    {
+        std::lock_guard<std::mutex> guard(_mtx_db_jobs_);
+        _mv_db_jobs_.push( std::move(job) );
+    }
+    _m_db_jobs_cv_.notify_one();
+}
+
+/****
+ * Retry-Engine related functions
+ */
+void CScheduler::arm_retry( uint32_t msg_id, const CPendingTable::CPending& pending ) {
+    try {
+        switch( pending.state ) {
+        case Tdb::Tstate::ENUM_TRIG:
+            _m_retry_.arm_ack(msg_id, 0);
+            break;
+        case Tdb::Tstate::ENUM_RCV_ACK:
+            _m_retry_.arm_start(msg_id, Tdb::get_when(pending.record));
+            break;
+        case Tdb::Tstate::ENUM_STARTED:
+            _m_retry_.arm_done(msg_id, pending.costtime);
+            break;
+        default:
+            _m_retry_.disarm(msg_id);
+            break;
+        }
+    }
+    catch ( const std::exception& e ) {
+        LOGERR("%s", e.what());
+        throw e;
+    }
+}
+
+void CScheduler::handle_expired( uint32_t msg_id, const CRetryEngine::CRetry& retry ) {
+    try {
+        bool is_changed = false;
+        Tdb::Trecord record;
+
+        // Deadline is armed in lock of pending-table by RX-thread too,
+        // so the last armed deadline is always for the current state.
+        // If state is changed already, then deadline of the current state is re-armed.
+        // (Because this expired deadline may have overwritten it.)
+        auto lamda_rearm = [this, msg_id, &is_changed](const CPendingTable::CPending& pending) -> void {
+            is_changed = true;
+            arm_retry(msg_id, pending);
+        };
+
+        // Re-send request with same msg-id, if ACK is not received.
+        if( _m_retry_.can_retry(retry) == true ) {
+            bool is_found = _m_pending_.visit(msg_id, [&](const CPendingTable::CPending& pending) -> void {
+                if( pending.state != retry.state ) {
+                    lamda_rearm( pending );
+                    return ;
+                }
+                _m_retry_.arm_ack(msg_id, retry.attempt + 1);
+                record = pending.record;
+            });
+
+            if( is_found == false || is_changed == true ) {
+                std::string info = "msg-id(" + std::to_string(msg_id) + ") is already changed.";
+                throw std::out_of_range(info);
+            }
+
+            auto peer = Tdb::get_who(record);
+            LOGW("ACK-timeout of msg-id(%u): re-send request to peer(%s/%s). (attempt=%u)", 
+                 msg_id, peer->app_path.data(), peer->pvd_id.data(), retry.attempt + 1);
+            post_request( *peer, Tdb::get_payload(record), msg_id );
+            return ;
+        }
+
+        // Timeout is exhausted, then move record from NOW-db to PAST-db with FAIL state.
+        if( _m_pending_.expire(msg_id, retry.state) == false ) {
+            _m_pending_.visit(msg_id, lamda_rearm);
+            std::string info = "msg-id(" + std::to_string(msg_id) + ") is already changed.";
+            throw std::out_of_range(info);
+        }
+
+        LOGW("Timeout of msg-id(%u) in state(%s): it's failed.", msg_id, Tdb::get_state_name(retry.state));
+        push_db_job( [this, msg_id]() -> void {
+            if( _m_db_.move_record_to_past(msg_id, Tdb::Tstate::ENUM_FAIL) == false ) {
+                LOGW("Record(msg-id: %u) is not exist in NOW-db.", msg_id);
+            }
+        });
+    }
+    catch ( const std::out_of_range& e ) {
+        LOGI("%s", e.what());
+    }
+    catch ( const std::exception& e ) {
+        LOGERR("%s", e.what());
+        throw e;
+    }
+}
+
+double CScheduler::get_costtime( const std::string& payload ) {
+    double costtime = principle::CHow::COSTTIME_NULL;
+    try {
+        auto json = std::make_shared<json_mng::CMjson>();
+        if( json->parse(payload.c_str(), payload.length()) != true ) {
+            throw std::runtime_error("Json Parsing is failed.");
+        }
+
+        auto chow = cmd::ICommand::extract_how(json);
+        if( chow->get_type() == principle::CHow::TYPE_VALVE ) {
+            costtime = chow->valve_costtime();
+        }
+    }
+    catch ( const std::exception& e ) {
+        LOGERR("%s", e.what());
+    }
+    return costtime;
+}
+
 /****
  * Thread related functions
  */
 void CScheduler::create_threads(void) {
     try {
         if( _m_is_continue_.exchange(true) == false ) {
-            LOGI("Create RX-cmd handle-thread.");
-            _mt_rcmd_handler_ = std::thread(&CScheduler::handle_rx_cmd, this);
+            LOGI("Start Peer-Sender workers.");
+            _m_sender_.start();
+
+            LOGI("Create RX-cmd handle-threads(%zu).", _mv_cmds_.size());
+            for( size_t shard=0; shard < _mv_cmds_.size(); shard++ ) {
+                _mv_rcmd_handlers_.push_back( std::thread(&CScheduler::handle_rx_cmd, this, shard) );
+            }
 
             LOGI("Create TX-cmd handle-thread.");
             _mt_scmd_handler_ = std::thread(&CScheduler::handle_tx_cmd, this);
 
-            if ( _mt_rcmd_handler_.joinable() == false ) {
-                _m_is_continue_ = false;
+            LOGI("Create DB-writer thread.");
+            {
+                std::lock_guard<std::mutex> guard(_mtx_db_jobs_);
+                _m_is_db_writing_ = true;
+            }
+            _mt_db_writer_ = std::thread(&CScheduler::handle_db_job, this);
+
+            LOGI("Create Retry handle-thread.");
+            _mt_retry_handler_ = std::thread(&CScheduler::handle_retry, this);
+
+            for( auto itr=_mv_rcmd_handlers_.begin(); itr!=_mv_rcmd_handlers_.end(); itr++ ) {
+                if ( itr->joinable() == false ) {
+                    _m_is_continue_ = false;
+                }
             }
 
             if ( _mt_scmd_handler_.joinable() == false ) {
                 _m_is_continue_ = false;
             }
+
+            if ( _mt_db_writer_.joinable() == false ) {
+                _m_is_continue_ = false;
+            }
+
+            if ( _mt_retry_handler_.joinable() == false ) {
+                _m_is_continue_ = false;
+            }
         }
 
         if( _m_is_continue_ == false ) {
@@ -286,16 +590,44 @@ void CScheduler::create_threads(void) {
 
 void CScheduler::destroy_threads(void) {
     if( _m_is_continue_.exchange(false) == true ) {
-        if( _mt_rcmd_handler_.joinable() == true ) {
-            LOGI("Destroy RX-cmd handle-thread.");     // Destroy of RX-cmd handle-thread.
-            _m_queue_cv_.notify_all();
-            _mt_rcmd_handler_.join();
+        LOGI("Destroy RX-cmd handle-threads.");        // Destroy of RX-cmd handle-threads.
+        for( size_t shard=0; shard < _mv_rcmd_handlers_.size(); shard++ ) {
+            if( _mv_rcmd_handlers_[shard].joinable() == true ) {
+                _mv_cmds_[shard]->stop();
+                _mv_rcmd_handlers_[shard].join();
+                LOGI("CMDs-queue[%zu]: depth=%zu, high-water=%zu, capacity=%zu", shard, 
+                     _mv_cmds_[shard]->depth(), _mv_cmds_[shard]->high_water(), _mv_cmds_[shard]->capacity());
+            }
         }
+        _mv_rcmd_handlers_.clear();
 
         if( _mt_scmd_handler_.joinable() == true ) {
             LOGI("Destroy TX-cmd handle-thread.");     // Destroy of TX-cmd handle-thread.
+            _m_timer_.stop();
             _mt_scmd_handler_.join();
         }
+
+        if( _mt_retry_handler_.joinable() == true ) {
+            LOGI("Destroy Retry handle-thread.");     // Destroy of Retry handle-thread.
+            _m_retry_.stop();
+            _mt_retry_handler_.join();
+        }
+
+        // Peer-Sender is stopped after the threads that post request.
+        LOGI("Stop Peer-Sender workers.");
+        _m_sender_.stop();
+        _m_sender_.print_counters();
+
+        // DB-writer is stopped after RX/TX threads, so the remained jobs are written to DB.
+        if( _mt_db_writer_.joinable() == true ) {
+            LOGI("Destroy DB-writer thread.");
+            {
+                std::lock_guard<std::mutex> guard(_mtx_db_jobs_);
+                _m_is_db_writing_ = false;
+            }
+            _m_db_jobs_cv_.notify_all();
+            _mt_db_writer_.join();
+        }
     }
 }
 
@@ -333,15 +665,6 @@ bool CScheduler::process_now_space( std::shared_ptr<cmd::ICommand>& cmd ) {
             throw std::invalid_argument("msg_id is NULL. (invalid CMD)");
         }
 
-        Tdb::TFPcond lamda_make_condition = [&msg_id](std::string kwho, std::string kwhen, 
-                                                      std::string kwhere, std::string kwhat, 
-                                                      std::string khow, std::string kuuid,
-                                                      std::map<Tdb::Tkey, std::string>& kopt) -> std::string {
-            // Load records from DataBase(NOW-DB) if "msg_id" is equal with targeting msg-id.
-            auto key_msgid = kopt[Tdb::Tkey::ENUM_MSG_ID];
-            return (key_msgid + " == " + std::to_string(msg_id) + " ORDER BY " + kwhen + " DESC");
-        };
-        
         // Get State value.
         if( ucmd->get_flag(Eflag::E_FLAG_ACK_MSG) ) {
             state = Tdb::Tstate::ENUM_RCV_ACK;
@@ -356,21 +679,36 @@ bool CScheduler::process_now_space( std::shared_ptr<cmd::ICommand>& cmd ) {
             state = Tdb::Tstate::ENUM_DONE;
         }
 
-        // Update State in NOW-db.
-        _m_db_.update_record(Tdb::Ttype::ENUM_NOW, Tdb::DB_TABLE_EVENT, 
-                             Tdb::Tkey::ENUM_MSG_ID, msg_id, 
-                             Tdb::Tkey::ENUM_STATE, state);
-
-        // If Action is Done/Fail, then move record from NOW-db to PAST-db.
+        // If Action is Done/Fail, then move record from NOW-db to PAST-db with the state.
         if( state == Tdb::Tstate::ENUM_FAIL || state == Tdb::Tstate::ENUM_DONE ) {
-            auto records = _m_db_.get_records(Tdb::Ttype::ENUM_NOW, Tdb::DB_TABLE_EVENT, lamda_make_condition, nullptr);
-            auto itr = records->begin();
-            if( itr == records->end() ) {
-                std::string err = "Record(msg-id: " + std::to_string(msg_id) + ") is not exist in NOW-db.";
+            if( _m_pending_.remove(msg_id) == false ) {
+                std::string err = "Record(msg-id: " + std::to_string(msg_id) + ") is not exist in pending-table.";
+                throw std::out_of_range(err);
+            }
+            _m_retry_.disarm(msg_id);
+
+            push_db_job( [this, msg_id, state]() -> void {
+                if( _m_db_.move_record_to_past(msg_id, state) == false ) {
+                    LOGW("Record(msg-id: %u) is not exist in NOW-db.", msg_id);
+                }
+            });
+        }
+        else {
+            // Update State in pending-table & NOW-db.
+            // Deadline of new state is armed in lock of pending-table. (refer to handle_expired)
+            bool is_updated = _m_pending_.update(msg_id, state, [this, msg_id](const CPendingTable::CPending& pending) -> void {
+                arm_retry(msg_id, pending);
+            });
+            if( is_updated == false ) {
+                std::string err = "Record(msg-id: " + std::to_string(msg_id) + ") is not exist in pending-table, or state is not progressed.";
                 throw std::out_of_range(err);
             }
-            _m_db_.insert_record(Tdb::Ttype::ENUM_PAST, Tdb::DB_TABLE_EVENT, *itr);
-            _m_db_.remove_record(Tdb::Ttype::ENUM_NOW, Tdb::DB_TABLE_EVENT, *itr);
+
+            push_db_job( [this, msg_id, state]() -> void {
+                _m_db_.update_record(Tdb::Ttype::ENUM_NOW, Tdb::DB_TABLE_EVENT, 
+                                     Tdb::Tkey::ENUM_MSG_ID, msg_id, 
+                                     Tdb::Tkey::ENUM_STATE, state);
+            });
         }
         result = true;
     }
@@ -426,28 +764,37 @@ void CScheduler::process_future_space( std::shared_ptr<cmd::ICommand>& rcmd ) {
         // If CMD is in-completed Task-Pair case, then throw Exception.
         ;   // TODO
 
-        // If "when" is relative-time or absolute-time is under now + 5 seconds, (Not "period when")
+        // If "when" is relative-time or absolute-time is under now + lead-time, (Not "period when")
         // Then trigger peer to do activity by the CMD immediatlly.
         if( t_when == principle::CWhen::TYPE_ONECE || t_when == principle::CWhen::TYPE_SPECIAL_TIME ) {
             double cur_time = time_pkg::CTime::get<double>();
 
-            if( when.get_start_time() <= (cur_time + 5.0) ) {
+            if( when.get_start_time() <= (cur_time + TIME_DISPATCH_LEAD) ) {
+                // costtime is taken from decoded 'how', so payload is not parsed again.
+                double costtime = principle::CHow::COSTTIME_NULL;
+                if( rcmd->how().get_type() == principle::CHow::TYPE_VALVE ) {
+                    costtime = rcmd->how().valve_costtime();
+                }
+
                 auto record = _m_db_.make_base_record(rcmd);
-                send_command( app_path, pvd_id, record );
+                send_command( app_path, pvd_id, record, costtime );
                 return ;
             }
         }
 
         // Classfy which When-info of CMD is EventBase-type or PeriodBase-type.
         // Store json-data of body in CMD to Database(Future-DB) according to type-info of "when" in CMD.
+        const char* table_name = Tdb::DB_TABLE_EVENT;
         if( t_when == principle::CWhen::TYPE_ROUTINE_DAY || t_when == principle::CWhen::TYPE_ROUTINE_WEEK ) {
             LOGD("Try to insert a record to Periodic-Table in Future.");
-            _m_db_.insert_record(Tdb::Ttype::ENUM_FUTURE, Tdb::DB_TABLE_PERIOD, rcmd);
+            table_name = Tdb::DB_TABLE_PERIOD;
         }
         else {
             LOGD("Try to insert a record to Event-Table in Future.");
-            _m_db_.insert_record(Tdb::Ttype::ENUM_FUTURE, Tdb::DB_TABLE_EVENT, rcmd);
         }
+
+        auto record = _m_db_.insert_record(Tdb::Ttype::ENUM_FUTURE, table_name, rcmd);
+        schedule_future_event(table_name, Tdb::get_uuid(record), Tdb::get_when(record));
     }
     catch( const std::exception& e ) {
         LOGERR("%s", e.what());
@@ -458,10 +805,10 @@ void CScheduler::process_future_space( std::shared_ptr<cmd::ICommand>& rcmd ) {
 /****
  * Treading for RX/TX Command
  */
-int CScheduler::handle_rx_cmd(void) {
+int CScheduler::handle_rx_cmd( size_t shard ) {
     while(_m_is_continue_.load()) {
         try {
-            auto rcmd = pop_cmd();      // Blocking 
+            auto rcmd = pop_cmd( shard );      // Blocking 
             if( rcmd.get() == NULL ) {
                 throw std::runtime_error("pop_cmd() is invalid operation.");
             }
@@ -484,51 +831,28 @@ int CScheduler::handle_rx_cmd(void) {
         }
     }
 
-    LOGI("Exit RX-cmd handle-thread.");
+    LOGI("Exit RX-cmd handle-thread[%zu].", shard);
     return 0;
 }
 
 int CScheduler::handle_tx_cmd(void) {
     while(_m_is_continue_.load()) {
         try {
-            Tdb& db_ref = _m_db_;
-            double cur_time = time_pkg::CTime::get<double>();
-            Tdb::TFPcond lamda_make_condition = [&cur_time](std::string kwho, std::string kwhen, 
-                                                    std::string kwhere, std::string kwhat, 
-                                                    std::string khow, std::string kuuid,
-                                                    std::map<Tdb::Tkey, std::string>& kopt) -> std::string {
-                // Load records from DataBase(Future-DB) if "when" is under now + 5 seconds.
-                return (kwhen + " <= " + std::to_string(cur_time + 5.0) + " ORDER BY " + kwhen + " ASC");
-            };
-            Tdb::TFPconvert lamda_convertor = [&](Tdb::Ttype db_type, Tdb::Trecord& record, std::string& payload) -> void {
-                // When we load json-data from PeriodBase tables, We must convert "period when" to "specific when".
-                double when = 0.0;
-                double next_when = 0.0;
-                std::string legacy_uuid = db_ref.get_uuid(record);
-
-                when = convert_json_to_event( payload, next_when );
-                db_ref.convert_record_to_event(db_type, record, when);
-                db_ref.update_record(db_type, Tdb::DB_TABLE_PERIOD, 
-                                     Tdb::Tkey::ENUM_UUID, legacy_uuid, 
-                                     Tdb::Tkey::ENUM_WHEN, next_when);
-            };
-
-            // We have to load json-data per tables. (EventBase/PeriodBase)
-            auto records = _m_db_.get_records(Tdb::Ttype::ENUM_FUTURE, Tdb::DB_TABLE_EVENT,  lamda_make_condition, nullptr );
-            _m_db_.get_records(Tdb::Ttype::ENUM_FUTURE, Tdb::DB_TABLE_PERIOD, lamda_make_condition, lamda_convertor, records );
-
-            // send command-msg to peer.
-            for( auto itr=records->begin(); itr!=records->end(); itr++ ) {
-                std::shared_ptr<Tdb::Trecord> record = *itr;
-                auto peer = Tdb::get_who(*record);
-                
-                send_command(*peer, record);
-                // remove record from Future-DB.  (Assumption: "get_records" about Future-DB is used only in this function.)
-                _m_db_.remove_record(Tdb::Ttype::ENUM_FUTURE, Tdb::DB_TABLE_EVENT, Tdb::get_uuid(*record));
+            Ttimer::TVentry events;
+
+            // Sleep until 'when' of the earliest event in Future-DB. (Blocking)
+            if( _m_timer_.wait_pop( events ) == false ) {
+                continue;
             }
 
-            // wait 5 seconds
-            std::this_thread::sleep_for(std::chrono::seconds(5));
+            for( auto itr=events.begin(); itr!=events.end(); itr++ ) {
+                try {
+                    dispatch_future_event( itr->first.first, itr->first.second );
+                }
+                catch (const std::exception &e) {
+                    LOGERR("%s", e.what());
+                }
+            }
         }
         catch (const std::exception &e) {
             LOGERR("%s", e.what());
@@ -539,5 +863,63 @@ int CScheduler::handle_tx_cmd(void) {
     return 0;
 }
 
+int CScheduler::handle_db_job(void) {
+    while( true ) {
+        TdbJob job;
+        {
+            std::unique_lock<std::mutex> lk(_mtx_db_jobs_);
+            _m_db_jobs_cv_.wait(lk, [&]() {
+                return ((false == _mv_db_jobs_.empty()) || (false == _m_is_db_writing_));
+            });
+
+            // Exit after all of jobs are written.
+            if( _mv_db_jobs_.empty() == true ) {
+                break;
+            }
+
+            job = std::move( _mv_db_jobs_.front() );
+            _mv_db_jobs_.pop();
+        }
+
+        try {
+            job();
+        }
+        catch (const std::exception &e) {
+            LOGERR("%s", e.what());
+        }
+    }
+
+    LOGI("Exit DB-writer thread.");
+    return 0;
+}
+
+int CScheduler::handle_retry(void) {
+    while(_m_is_continue_.load()) {
+        try {
+            CRetryEngine::TVexpired expired;
+
+            // Sleep until the earliest timeout of in-flight commands. (Blocking)
+            if( _m_retry_.wait_expired( expired ) == false ) {
+                continue;
+            }
+
+            for( auto itr=expired.begin(); itr!=expired.end(); itr++ ) {
+                try {
+                    handle_expired( itr->first, itr->second );
+                }
+                catch (const std::exception &e) {
+                    LOGERR("%s", e.what());
+                }
+            }
+        }
+        catch (const std::exception &e) {
+            LOGERR("%s", e.what());
+        }
+    }
+
+    LOGI("Exit Retry handle-thread.");
+    return 0;
+}
+
 
 }   // service
\ No newline at end of file
@@ -7,6 +7,7 @@
 
 #include <ICommand.h>
 #include <CDBsqlite.h>
+#include <CRecord.h>
 #include <Common.h>
 
 namespace db {
@@ -14,39 +15,26 @@ namespace db {
 
 class CDBhandler {
 public:
-    using Trecord = db_pkg::CDBsqlite::Trecord;
-    using TVrecord = db_pkg::CDBsqlite::TVrecord;
+    using Trecord = CRecord;
+    using TVrecord = std::vector<CRecord>;
+    using Tvalue = db_pkg::CDBsqlite::CValue;
+    using TVvalue = db_pkg::CDBsqlite::TVvalue;
     using Tstate = enum class enum_state: uint8_t { ENUM_TRIG=1, ENUM_RCV_ACK=2, ENUM_STARTED=3, ENUM_DONE=4, ENUM_FAIL=5 };
     using Ttype = enum class enum_db_type: uint8_t { ENUM_FUTURE=1, ENUM_NOW=2, ENUM_PAST=3 };
-    using Tkey = enum class enum_key_type: uint16_t {
-        ENUM_MSG_ID=1,
-        ENUM_STATE=2,
-        ENUM_PERIOD=3,
-        ENUM_PERIOD_TYPE=4,
-        ENUM_FIRSTWHEN=5,
-        ENUM_WHEN_TEXT=6,
-
-        ENUM_ID,
-        ENUM_UUID,
-        ENUM_WHO,
-        ENUM_WHEN,
-        ENUM_WHERE,
-        ENUM_WHAT,
-        ENUM_HOW,
-        ENUM_PAYLOAD
-    };
+    using Tkey = db::Tkey;
 
     // Function Pointer type.
-    using TFPselect = db_pkg::CDBsqlite::TCBselect;
     using TFPcond = std::function<std::string (std::string /*key who*/, std::string /*key when*/, 
                                                std::string /*key where*/, std::string /*key what*/, 
                                                std::string /*key how*/, std::string /*key uuid*/,
-                                               std::map<Tkey, std::string>& /*Option keys*/)>;
+                                               std::map<Tkey, std::string>& /*Option keys*/,
+                                               TVvalue& /*values for '?' in condition*/)>;
     using TFPconvert = std::function<void (Ttype /*db_type*/, Trecord& /*record*/, std::string& /*payload*/)>;
+    using TFPschedule = std::function<void (const std::string& /*uuid*/, double /*when*/)>;
 
 private:
-    using TRecordHandler = std::function<std::string(std::shared_ptr<cmd::ICommand> /*cmd*/, std::shared_ptr<Trecord> /*record*/)>;
-    using TCondHandler = std::function<std::string(TFPcond&)>;
+    using TRecordHandler = std::function<std::string(std::shared_ptr<cmd::ICommand> /*cmd*/, Trecord& /*record*/, TVvalue& /*values*/)>;
+    using TCondHandler = std::function<std::string(TFPcond&, TVvalue&)>;
     using TMrHandler = std::map<std::string /*table-name*/, TRecordHandler>;
     using TMcHandler = std::map<std::string /*table-name*/, TCondHandler>;
 
@@ -57,34 +45,27 @@ public:
 
     bool convert_record_to_event(Ttype db_type, Trecord& record, double when);
 
-    std::shared_ptr<Trecord> make_base_record(std::shared_ptr<cmd::ICommand>& cmd);
-
-    template<typename T>
-    static void append(std::shared_ptr<Trecord>& record, Tkey key, T value) {
-        std::string s_key = _gm_key_names_all_.find(key)->second;
-        (*record)[ s_key ] = convert_string<T>(value);
-    }
+    Trecord make_base_record(std::shared_ptr<cmd::ICommand>& cmd);
 
     // setter
-    void insert_record(Ttype db_type, const char* table_name, std::shared_ptr<Trecord>& record);
+    void insert_record(Ttype db_type, const char* table_name, Trecord& record);
 
-    void insert_record(Ttype db_type, const char* table_name, std::shared_ptr<cmd::ICommand>& cmd);
+    Trecord insert_record(Ttype db_type, const char* table_name, std::shared_ptr<cmd::ICommand>& cmd);
 
-    void remove_record(Ttype db_type, const char* table_name, std::shared_ptr<Trecord>& record);
+    void remove_record(Ttype db_type, const char* table_name, const Trecord& record);
 
     void remove_record(Ttype db_type, const char* table_name, const std::string uuid);
 
+    bool move_record_to_past(uint32_t msg_id, Tstate state);
+
     template<typename TC, typename TU>
     void update_record(Ttype db_type, const char* table_name, 
                        Tkey cond_key, TC cond_val, 
                        Tkey update_key, TU update_val) {
-        std::string scond_val = convert_string<TC>( cond_val );
-        std::string supdate_val = convert_string<TU>( update_val );
-
-        scond_val = get_value_context(cond_key, scond_val);
-        supdate_val = get_value_context(update_key, supdate_val);
+        Tvalue vcond = make_value<TC>( cond_val );
+        Tvalue vupdate = make_value<TU>( update_val );
 
-        update_record_raw(db_type, table_name, cond_key, scond_val, update_key, supdate_val);
+        update_record_raw(db_type, table_name, cond_key, vcond, update_key, vupdate);
     }
 
     // getter
@@ -92,11 +73,24 @@ public:
                                           TFPcond& conditioner, TFPconvert convertor, 
                                           std::shared_ptr<TVrecord> records=std::shared_ptr<TVrecord>());
 
+    void get_schedules(Ttype db_type, const char* table_name, TFPschedule func);
+
     static std::shared_ptr<alias::CAlias> get_who(const Trecord& record);
 
-    static std::string get_payload(const Trecord& record);
+    static const std::string& get_payload(const Trecord& record);
 
-    static std::string get_uuid(const Trecord& record);
+    static const std::string& get_uuid(const Trecord& record);
+
+    static double get_when(const Trecord& record);
+
+    static const char* get_state_name(Tstate state);
+
+    static Tstate get_state(const std::string& state_name);
+
+    template<typename T>
+    static Tvalue make_value(T value) {
+        return Tvalue(value);
+    }
 
 private:
     CDBhandler(const CDBhandler&) = delete;             // copy constructor
@@ -104,20 +98,34 @@ private:
     CDBhandler(CDBhandler&&) = delete;                  // move constructor
     CDBhandler& operator=(CDBhandler&&) = delete;       // move operator
 
-    static std::string get_record_data( const Trecord& record, const std::string key );
+    static const CLayout& get_layout( Ttype db_type, const std::string& table );
 
     std::shared_ptr<db_pkg::CDBsqlite>& get_db_instance( Ttype db_type );
 
     void regist_handlers_4_context_maker(void);
 
-    template<typename T>
-    static std::string convert_string(T value);
+    void attach_now_to_past(void);
+
+    void check_query_plans(void);
+
+    /** Contexts of hot queries. (They're shared with check_query_plans(), so the checked plan is same with executed one.) */
+    static std::string context_of_schedules( const std::string& table );
+
+    static std::string context_of_fetch( const CLayout& layout, const std::string& table, const std::string& condition );
+
+    static std::string context_of_remove( const std::string& table );
+
+    static std::string context_of_update( const std::string& table, Tkey cond_key, Tkey update_key );
+
+    static std::string context_of_move_copy(void);
 
-    std::string get_value_context(Tkey key, std::string& value);
+    static std::string context_of_move_remove(void);
+
+    static std::string context_of_clean_moved(void);
 
     void update_record_raw(Ttype db_type, const char* table_name, 
-                           Tkey cond_key, std::string& cond_val, 
-                           Tkey update_key, std::string& update_val);
+                           Tkey cond_key, Tvalue& cond_val, 
+                           Tkey update_key, Tvalue& update_val);
 
 public:
     #define TABLE_EVENT     "EventBase"
@@ -125,6 +133,12 @@ public:
     static constexpr const char * DB_TABLE_EVENT = TABLE_EVENT;
     static constexpr const char * DB_TABLE_PERIOD = TABLE_PERIOD;
 
+    // Layout (ordered columns) of each table.
+    static const CLayout LAYOUT_FUTURE_EVENT;
+    static const CLayout LAYOUT_FUTURE_PERIOD;
+    static const CLayout LAYOUT_NOW_EVENT;
+    static const CLayout LAYOUT_PAST_EVENT;
+
 private:
     /* DB related variables. */
     std::map<Ttype, std::shared_ptr<db_pkg::CDBsqlite>> _mm_db_;
@@ -133,30 +147,15 @@ private:
 
     std::map<Ttype, TMcHandler> _mm_make_context_4con_;
 
-    static const std::map<Tkey, std::string> _gm_key_names_all_;
+    static const std::map<Ttype, std::map<std::string /*table-name*/, const CLayout*>> _gm_layouts_;
 
-    static const std::map<Ttype, std::map<Tkey, std::string>> _gm_key_names_;
-    
     // define DB-path
     static constexpr const char * DB_NAME_FUTURE = "db_future.db";
     static constexpr const char * DB_NAME_NOW = "db_now.db";
     static constexpr const char * DB_NAME_PAST = "db_past.db";
 
-    // define KEY
-    #define KEY_ID          "id"
-    #define KEY_UUID        "uuid"
-    #define KEY_WHO         "who"
-    #define KEY_WHEN_TEXT   "when_text"
-    #define KEY_WHEN        "when_utc"
-    #define KEY_FIRSTWHEN   "when_first"
-    #define KEY_PERIOD_TYPE "period_type"
-    #define KEY_PERIOD      "period"
-    #define KEY_WHERE       "where_pos"
-    #define KEY_WHAT        "what"
-    #define KEY_HOW         "how"
-    #define KEY_PAYLOAD     "payload"
-    #define KEY_MSG_ID      "msg_id"
-    #define KEY_STATE       "state"
+    // schema-name of NOW-DB attached to connection of PAST-DB.
+    static constexpr const char * DB_SCHEMA_NOW = "now";
 
     // define Table-Model
     #define TMODEL_EVENT    \
@@ -170,6 +169,18 @@ private:
            KEY_HOW       " TEXT                                            NOT NULL,"   \
            KEY_PAYLOAD   " TEXT                                            NOT NULL"
 
+    // uuid of PAST-DB is not UNIQUE, because periodic or re-issued command reuses uuid.
+    #define TMODEL_PAST_EVENT    \
+           KEY_ID        " INTEGER     PRIMARY KEY     AUTOINCREMENT       NOT NULL,"   \
+           KEY_UUID      " TEXT                                            NOT NULL,"   \
+           KEY_WHO       " TEXT                                            NOT NULL,"   \
+           KEY_WHEN_TEXT " TEXT                                            NOT NULL,"   \
+           KEY_WHEN      " REAL                                            NOT NULL,"   \
+           KEY_WHERE     " TEXT                                            NOT NULL,"   \
+           KEY_WHAT      " TEXT                                            NOT NULL,"   \
+           KEY_HOW       " TEXT                                            NOT NULL,"   \
+           KEY_PAYLOAD   " TEXT                                            NOT NULL"
+
     #define TMODEL_PERIOD   \
            KEY_ID           " INTEGER     PRIMARY KEY     AUTOINCREMENT       NOT NULL,"   \
            KEY_UUID         " TEXT        UNIQUE                              NOT NULL,"   \
@@ -247,18 +258,59 @@ private:
          * payload  : json-data
          * state    : state of CMD operation    Valid-Values) TRIGGERED, RCV-ACK, STARTED, DONE, FAIL
          * msg-id   : ID of req-msg that is sent.
-         * uuid     : who@when-text@where@what@how for uniqueness as ID.
+         * uuid     : who@when-text@where@what@how. (Not unique: it's recorded per execution of periodic/re-issued command.)
          ***/
         TABLE_EVENT "(" \
-            TMODEL_EVENT ","    \
+            TMODEL_PAST_EVENT ","    \
             KEY_MSG_ID   " INTEGER                                         NOT NULL,"   \
             KEY_STATE    " TEXT                                            NOT NULL"    \
         ")",
         NULL
     };
 
+    // Version of Table/Index-Model. (Increase it, if TABLE_MODEL_* or INDEX_MODEL_* is changed. Then old DB-file is migrated.)
+    static constexpr int DB_SCHEMA_VERSION = 3;
+
+    // define Index-Name
+    #define INDEX_EVENT_WHEN        "idx_event_when"
+    #define INDEX_PERIOD_WHEN       "idx_period_when"
+    #define INDEX_EVENT_MSG_ID      "idx_event_msg_id"
+    #define INDEX_EVENT_UUID_MSG_ID "idx_event_uuid_msg_id"
+
+    // define Index-Model
+    static constexpr const char * INDEX_MODEL_FUTURE[] = {
+        /***
+         * when-utc + uuid : covering index for loading schedules ordered by when-utc.
+         ***/
+        INDEX_EVENT_WHEN " ON " TABLE_EVENT "(" KEY_WHEN "," KEY_UUID ")",
+        INDEX_PERIOD_WHEN " ON " TABLE_PERIOD "(" KEY_WHEN "," KEY_UUID ")",
+        NULL
+    };
+
+    static constexpr const char * INDEX_MODEL_NOW[] = {
+        /***
+         * msg-id : update of state & moving to PAST-DB by ACK/START/RESP message.
+         ***/
+        INDEX_EVENT_MSG_ID " ON " TABLE_EVENT "(" KEY_MSG_ID ")",
+        NULL
+    };
+
+    static constexpr const char * INDEX_MODEL_PAST[] = {
+        /***
+         * uuid + msg-id : clean-up of NOW-DB at start-up. (records already moved to PAST-DB)
+         *                 Otherwise PAST-DB is only appended by move_record_to_past().
+         ***/
+        INDEX_EVENT_UUID_MSG_ID " ON " TABLE_EVENT "(" KEY_UUID "," KEY_MSG_ID ")",
+        NULL
+    };
+
 };
 
+template<>
+inline CDBhandler::Tvalue CDBhandler::make_value<CDBhandler::Tstate>(Tstate value) {
+    return Tvalue( get_state_name(value) );
+}
+
 
 }   // namespace db
 
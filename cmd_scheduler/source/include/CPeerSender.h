@@ -0,0 +1,107 @@
+#ifndef _CLASS_PEER_SENDER_H_
+#define _CLASS_PEER_SENDER_H_
+
+#include <map>
+#include <deque>
+#include <queue>
+#include <mutex>
+#include <thread>
+#include <string>
+#include <vector>
+#include <functional>
+#include <condition_variable>
+
+namespace service {
+
+
+/***
+ * Outbound executor that has a queue per peer. (strand)
+ *  - Jobs of a peer are executed in order, and only one worker runs them at a time.
+ *  - Jobs of different peers are executed in parallel by worker-pool,
+ *    so one slow peer does not block sending to other peers.
+ ***/
+class CPeerSender {
+public:
+    using TJob = std::function<void(void)>;
+
+    class CCounter {
+    public:
+        CCounter( void ) : depth(0), depth_max(0), done(0), latency_sum(0.0), latency_max(0.0) {}
+
+        double latency_avg( void ) const { return done == 0 ? 0.0 : latency_sum / done; }
+
+        size_t depth;           // count of jobs waiting in queue.
+
+        size_t depth_max;       // high-water mark of depth.
+
+        uint64_t done;          // count of executed jobs.
+
+        double latency_sum;     // [seconds] sum of latency. (from post() to end of job)
+
+        double latency_max;     // [seconds]
+
+    };
+
+    using TMcounter = std::map<std::string /*peer*/, CCounter>;
+
+public:
+    static constexpr size_t DEFAULT_WORKER_CNT = 4;
+
+public:
+    CPeerSender( size_t worker_cnt=DEFAULT_WORKER_CNT );
+
+    ~CPeerSender( void );
+
+    void start( void );
+
+    /** Stop workers after all of posted jobs are executed. */
+    void stop( void );
+
+    void post( const std::string& peer, TJob job );
+
+    TMcounter get_counters( void );
+
+    void print_counters( void );
+
+private:
+    CPeerSender(const CPeerSender&) = delete;             // copy constructor
+    CPeerSender& operator=(const CPeerSender&) = delete;  // copy operator
+    CPeerSender(CPeerSender&&) = delete;                  // move constructor
+    CPeerSender& operator=(CPeerSender&&) = delete;       // move operator
+
+    int handle_jobs( void );
+
+private:
+    class CStrand {
+    public:
+        CStrand( void ) : is_scheduled(false) {}
+
+        std::deque<std::pair<double /*posted time*/, TJob>> jobs;
+
+        bool is_scheduled;      // whether it's in ready-queue or is running by worker.
+
+        CCounter counter;
+
+    };
+
+    size_t _m_worker_cnt_;
+
+    bool _m_is_continue_;
+
+    std::map<std::string /*peer*/, CStrand> _mm_strands_;
+
+    std::queue<std::string /*peer*/> _mv_ready_;
+
+    std::vector<std::thread> _mv_workers_;
+
+    std::mutex _mtx_strands_;
+
+    std::condition_variable _m_cv_;
+
+};
+
+
+}   // namespace service
+
+
+#endif // _CLASS_PEER_SENDER_H_
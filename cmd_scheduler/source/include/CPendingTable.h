@@ -0,0 +1,83 @@
+#ifndef _CLASS_PENDING_TABLE_H_
+#define _CLASS_PENDING_TABLE_H_
+
+#include <mutex>
+#include <functional>
+#include <unordered_map>
+
+#include <CDBhandler.h>
+#include <CuCMD/CMsgIdAllocator.h>
+
+namespace service {
+
+
+/***
+ * In-memory table of in-flight commands in NOW-space. (msg-id -> record + state + costtime)
+ *  - It's the primary lookup for ACK/START/RESP/ERROR messages. (O(1))
+ *  - NOW-DB is a durable copy of this table, so it's loaded from NOW-DB at start-up.
+ *  - msg-ids in this table are registered to CMsgIdAllocator, so new request never reuses in-flight msg-id.
+ ***/
+class CPendingTable {
+public:
+    using Tdb = db::CDBhandler;
+
+    class CPending {
+    public:
+        CPending( void ) : state(Tdb::Tstate::ENUM_TRIG), costtime(::principle::CHow::COSTTIME_NULL) {}
+
+        Tdb::Trecord record;
+
+        Tdb::Tstate state;
+
+        double costtime;        // costtime of 'how' in payload. (It's extracted once, when it's registered.)
+
+    };
+
+    using TFvisit = std::function<void(const CPending& pending)>;
+
+public:
+    CPendingTable( void );
+
+    ~CPendingTable( void );
+
+    /** Register new in-flight command. return false, if msg-id is already exist. */
+    bool insert( uint32_t msg_id, const Tdb::Trecord& record, Tdb::Tstate state, 
+                 double costtime=::principle::CHow::COSTTIME_NULL );
+
+    /** Update state of command. return false, if msg-id is not exist or state is not progressed. (Ex: duplicated ACK)
+     *  on_updated is called in lock of table, so deadline of new state is armed before other thread sees the state. */
+    bool update( uint32_t msg_id, Tdb::Tstate state, const TFvisit& on_updated=nullptr );
+
+    /** Remove completed command. return false, if msg-id is not exist. */
+    bool remove( uint32_t msg_id );
+
+    /** Remove timed-out command only if it's still in the state. return false, if state is changed already. */
+    bool expire( uint32_t msg_id, Tdb::Tstate state );
+
+    /** Call func in lock of table, so state of command is not changed while func is running. return false, if msg-id is not exist. */
+    bool visit( uint32_t msg_id, const TFvisit& func );
+
+    size_t size( void );
+
+    void clear( void );
+
+private:
+    CPendingTable(const CPendingTable&) = delete;             // copy constructor
+    CPendingTable& operator=(const CPendingTable&) = delete;  // copy operator
+    CPendingTable(CPendingTable&&) = delete;                  // move constructor
+    CPendingTable& operator=(CPendingTable&&) = delete;       // move operator
+
+private:
+    std::unordered_map<uint32_t /*msg-id*/, CPending> _mm_pending_;
+
+    std::mutex _mtx_pending_;
+
+    cmd::CMsgIdAllocator& _m_msg_ids_;      // registry of in-flight msg-ids.
+
+};
+
+
+}   // namespace service
+
+
+#endif // _CLASS_PENDING_TABLE_H_
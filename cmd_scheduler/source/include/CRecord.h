@@ -0,0 +1,193 @@
+#ifndef _CLASS_DATABASE_RECORD_H_
+#define _CLASS_DATABASE_RECORD_H_
+
+#include <tuple>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <stdexcept>
+#include <initializer_list>
+
+#include <sqlite3_kes.h>
+
+namespace db {
+
+
+using Tkey = enum class enum_key_type: uint16_t {
+    ENUM_MSG_ID=1,
+    ENUM_STATE=2,
+    ENUM_PERIOD=3,
+    ENUM_PERIOD_TYPE=4,
+    ENUM_FIRSTWHEN=5,
+    ENUM_WHEN_TEXT=6,
+
+    ENUM_ID,
+    ENUM_UUID,
+    ENUM_WHO,
+    ENUM_WHEN,
+    ENUM_WHERE,
+    ENUM_WHAT,
+    ENUM_HOW,
+    ENUM_PAYLOAD
+};
+
+using Tmask = uint32_t;
+
+constexpr size_t key_index( Tkey key ) {
+    return static_cast<size_t>(key) - 1;
+}
+
+constexpr Tmask key_bit( Tkey key ) {
+    return static_cast<Tmask>(1) << key_index(key);
+}
+
+constexpr Tmask key_mask( void ) {
+    return 0;
+}
+
+template <typename... Tkeys>
+constexpr Tmask key_mask( Tkey key, Tkeys... keys ) {
+    return key_bit(key) | key_mask(keys...);
+}
+
+// define KEY (column-name of tables)
+#define KEY_ID          "id"
+#define KEY_UUID        "uuid"
+#define KEY_WHO         "who"
+#define KEY_WHEN_TEXT   "when_text"
+#define KEY_WHEN        "when_utc"
+#define KEY_FIRSTWHEN   "when_first"
+#define KEY_PERIOD_TYPE "period_type"
+#define KEY_PERIOD      "period"
+#define KEY_WHERE       "where_pos"
+#define KEY_WHAT        "what"
+#define KEY_HOW         "how"
+#define KEY_PAYLOAD     "payload"
+#define KEY_MSG_ID      "msg_id"
+#define KEY_STATE       "state"
+
+
+/***
+ * Fixed-layout record for rows of EventBase/PeriodBase tables.
+ *  - Columns are stored in tuple that is indexed by Tkey, so type of each column is decided at compile-time.
+ *  - mask has bits of columns that are set in this record.
+ ***/
+class CRecord {
+public:
+    using Tvalue = db_pkg::IDBsqlite3::CValue;
+    using Tstatement = db_pkg::IDBsqlite3::CStatement;
+    using Tcolumns = std::tuple< int64_t        /*ENUM_MSG_ID*/,
+                                 std::string    /*ENUM_STATE*/,
+                                 int64_t        /*ENUM_PERIOD*/,
+                                 std::string    /*ENUM_PERIOD_TYPE*/,
+                                 std::string    /*ENUM_FIRSTWHEN*/,
+                                 std::string    /*ENUM_WHEN_TEXT*/,
+                                 int64_t        /*ENUM_ID*/,
+                                 std::string    /*ENUM_UUID*/,
+                                 std::string    /*ENUM_WHO*/,
+                                 double         /*ENUM_WHEN*/,
+                                 std::string    /*ENUM_WHERE*/,
+                                 std::string    /*ENUM_WHAT*/,
+                                 std::string    /*ENUM_HOW*/,
+                                 std::string    /*ENUM_PAYLOAD*/ >;
+
+    template <Tkey K>
+    using Ttype = typename std::tuple_element<key_index(K), Tcolumns>::type;
+
+    static constexpr size_t COLUMN_CNT = std::tuple_size<Tcolumns>::value;
+
+public:
+    CRecord( void ) : _m_mask_(0) {}
+
+    template <Tkey K>
+    const Ttype<K>& get( void ) const {
+        if( has(K) == false ) {
+            throw std::logic_error( std::string(get_name(K)) + " is not exist in record." );
+        }
+        return std::get<key_index(K)>(_m_columns_);
+    }
+
+    template <Tkey K>
+    Ttype<K>& at( void ) {
+        if( has(K) == false ) {
+            throw std::logic_error( std::string(get_name(K)) + " is not exist in record." );
+        }
+        return std::get<key_index(K)>(_m_columns_);
+    }
+
+    template <Tkey K>
+    void set( Ttype<K> value ) {
+        std::get<key_index(K)>(_m_columns_) = std::move(value);
+        _m_mask_ |= key_bit(K);
+    }
+
+    bool has( Tkey key ) const {
+        return (_m_mask_ & key_bit(key)) != 0;
+    }
+
+    bool has_all( Tmask mask ) const {
+        return (_m_mask_ & mask) == mask;
+    }
+
+    Tmask mask( void ) const {
+        return _m_mask_;
+    }
+
+    void retain( Tmask mask ) {     // drop columns that are not in mask.
+        _m_mask_ &= mask;
+    }
+
+    void clear( void ) {
+        _m_mask_ = 0;
+    }
+
+    /** Access to column by runtime-key for binding/loading of DB. */
+    Tvalue get_value( Tkey key ) const;
+
+    void set_column( Tkey key, const Tstatement& stmt, int col );
+
+    static const char* get_name( Tkey key );
+
+private:
+    Tcolumns _m_columns_;
+
+    Tmask _m_mask_;
+
+};
+
+
+/***
+ * Ordered columns of a table. (It makes column-list & '?'-parameters of query.)
+ ***/
+class CLayout {
+public:
+    CLayout( std::initializer_list<Tkey> keys );
+
+    const std::vector<Tkey>& keys( void ) const { return _mv_keys_; }
+
+    Tmask mask( void ) const { return _m_mask_; }
+
+    const std::string& columns( void ) const { return _m_columns_; }    // Ex) "uuid,who,when_utc"
+
+    const std::string& params( void ) const { return _m_params_; }      // Ex) "?,?,?"
+
+    void get_values( const CRecord& record, db_pkg::IDBsqlite3::TVvalue& values ) const;
+
+    void load( CRecord& record, const CRecord::Tstatement& stmt ) const;
+
+private:
+    std::vector<Tkey> _mv_keys_;
+
+    Tmask _m_mask_;
+
+    std::string _m_columns_;
+
+    std::string _m_params_;
+
+};
+
+
+}   // namespace db
+
+
+#endif // _CLASS_DATABASE_RECORD_H_
@@ -0,0 +1,85 @@
+#ifndef _CLASS_RETRY_ENGINE_H_
+#define _CLASS_RETRY_ENGINE_H_
+
+#include <CDBhandler.h>
+#include <deadline_queue_kes.h>
+
+namespace service {
+
+
+/***
+ * Deadline-driven timeout of in-flight commands keyed by msg-id.
+ *  - Each msg-id has only one deadline according to its state.
+ *      TRIGGERED : ACK-timeout with exponential backoff. (request is re-sent until MAX_RETRY)
+ *      RCV_ACK   : 'when' of command + START-slack.
+ *      STARTED   : cost-time of command + DONE-slack.
+ *  - Expired entries are popped by wait_expired() without scanning of NOW-DB.
+ ***/
+class CRetryEngine {
+public:
+    using Tstate = db::CDBhandler::Tstate;
+
+    class CRetry {
+    public:
+        CRetry( Tstate _state_=Tstate::ENUM_TRIG, uint32_t _attempt_=0 ) : state(_state_), attempt(_attempt_) {}
+
+        Tstate state;           // state that is waited to be changed.
+
+        uint32_t attempt;       // count of re-sent request. (It's valid only for TRIGGERED)
+
+    };
+
+    using Ttimer = time_pkg::CDeadlineQueue<uint32_t /*msg-id*/, CRetry>;
+    using TVexpired = Ttimer::TVentry;
+
+public:
+    static constexpr double TIMEOUT_ACK = 3.0;          // [seconds] ACK-timeout of first request.
+    static constexpr double TIMEOUT_ACK_MAX = 60.0;     // [seconds] upper-bound of ACK-timeout by backoff.
+    static constexpr double BACKOFF_FACTOR = 2.0;
+    static constexpr uint32_t MAX_RETRY = 5;            // count of re-sending request.
+    static constexpr double SLACK_START = 60.0;         // [seconds] ACT-START must be received until when + it.
+    static constexpr double SLACK_DONE = 60.0;          // [seconds] RESP must be received until cost-time + it.
+
+public:
+    CRetryEngine( void ) = default;
+
+    ~CRetryEngine( void ) = default;
+
+    /** Wait ACK of request. (attempt: count of re-sent request) */
+    void arm_ack( uint32_t msg_id, uint32_t attempt );
+
+    /** Wait ACT-START of peer that is started at 'when'. */
+    void arm_start( uint32_t msg_id, double when );
+
+    /** Wait RESP of peer that is done after cost-time. */
+    void arm_done( uint32_t msg_id, double costtime );
+
+    bool disarm( uint32_t msg_id );
+
+    bool can_retry( const CRetry& retry ) const {
+        return retry.state == Tstate::ENUM_TRIG && retry.attempt < MAX_RETRY;
+    }
+
+    /** Blocking until some of deadlines are expired, or stop() is called. (then return false) */
+    bool wait_expired( TVexpired& expired );
+
+    size_t size( void );
+
+    void stop( void );
+
+private:
+    CRetryEngine(const CRetryEngine&) = delete;             // copy constructor
+    CRetryEngine& operator=(const CRetryEngine&) = delete;  // copy operator
+    CRetryEngine(CRetryEngine&&) = delete;                  // move constructor
+    CRetryEngine& operator=(CRetryEngine&&) = delete;       // move operator
+
+private:
+    Ttimer _m_timer_;
+
+};
+
+
+}   // namespace service
+
+
+#endif // _CLASS_RETRY_ENGINE_H_
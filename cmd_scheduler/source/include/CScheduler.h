@@ -7,12 +7,18 @@
 #include <atomic>
 #include <mutex>
 #include <queue>
+#include <vector>
 #include <condition_variable>
 
 #include <Common.h>
 #include <CuCMD/MCommunicator.h>
 #include <ICommand.h>
 #include <CDBhandler.h>
+#include <CPendingTable.h>
+#include <CRetryEngine.h>
+#include <CPeerSender.h>
+#include <deadline_queue_kes.h>
+#include <mpsc_ring_kes.h>
 
 namespace service {
 
@@ -27,6 +33,10 @@ private:
     using Tdb = db::CDBhandler;
     using Eflag = cmd::CuCMD::E_FLAG;
     using Estate = cmd::CuCMD::E_STATE;
+    using TtimerKey = std::pair<std::string /*table-name*/, std::string /*uuid*/>;   // uuid is unique only in a table.
+    using Ttimer = time_pkg::CDeadlineQueue<TtimerKey, double /*when*/>;
+    using TdbJob = std::function<void(void)>;
+    using TCMDqueue = lock_pkg::CMPSCring<std::shared_ptr<cmd::ICommand>>;
 
 public:
     static std::shared_ptr<CScheduler> get_instance( void );
@@ -52,16 +62,41 @@ private:
     void receive_command( std::shared_ptr<cmd::ICommand>& cmd );
 
     void send_command( const std::string& peer_app, const std::string& peer_pvd, 
-                       std::shared_ptr<Tdb::Trecord>& record );
+                       Tdb::Trecord& record, double costtime );
 
-    void send_command( alias::CAlias& peer, std::shared_ptr<Tdb::Trecord>& record );
+    void send_command( alias::CAlias& peer, Tdb::Trecord& record );
+
+    void send_command( alias::CAlias& peer, Tdb::Trecord& record, double costtime );
+
+    void post_request( const alias::CAlias& peer, const std::string& payload, uint32_t msg_id );
 
     void push_cmd( std::shared_ptr<cmd::ICommand>& cmd );
 
-    std::shared_ptr<cmd::ICommand> pop_cmd( void );     // Blocking function.
+    std::shared_ptr<cmd::ICommand> pop_cmd( size_t shard );     // Blocking function.
+
+    static size_t get_rx_worker_count( void );
 
     double convert_json_to_event( std::string& payload, double& next_when );
 
+    /** Dispatch-Timer related Functions for Future-DB. */
+    void load_future_events( void );
+
+    void schedule_future_event( const char* table_name, const std::string& uuid, double when );
+
+    void dispatch_future_event( const std::string& table, const std::string& uuid );
+
+    /** Pending-Table related Functions for NOW-space. */
+    void load_pending_commands( void );
+
+    void push_db_job( TdbJob job );     // NOW/PAST-DB is written asynchronously by DB-writer thread.
+
+    /** Retry-Engine related Functions for NOW-space. */
+    void arm_retry( uint32_t msg_id, const CPendingTable::CPending& pending );
+
+    void handle_expired( uint32_t msg_id, const CRetryEngine::CRetry& retry );
+
+    static double get_costtime( const std::string& payload );
+
     /** Thread releated Functions. */
     void create_threads(void);
 
@@ -73,29 +108,57 @@ private:
 
     void process_future_space( std::shared_ptr<cmd::ICommand>& cmd );
 
-    int handle_rx_cmd(void);
+    int handle_rx_cmd( size_t shard );
 
     int handle_tx_cmd(void);
 
+    int handle_db_job(void);
+
+    int handle_retry(void);
+
 private:
+    /* Event of Future-DB is sent to peer before 'when' by this lead-time. [seconds] */
+    static constexpr double TIME_DISPATCH_LEAD = 5.0;
+
+    /* Capacity of Queue for received CMDs. (per RX-worker) */
+    static constexpr size_t RX_QUEUE_SIZE = 4096;
+
+    /* Count of RX-workers. (It can be changed by environment variable.) */
+    static constexpr size_t DEFAULT_RX_WORKERS = 4;
+    static constexpr size_t MAX_RX_WORKERS = 64;
+    static constexpr const char* ENV_RX_WORKERS = "SCHEDULER_RX_WORKERS";
+
     std::shared_ptr<comm::MCommunicator>  _m_comm_mng_;
 
     Tdb _m_db_;
 
+    Ttimer _m_timer_;                    // Dispatch-timer of EventBase/PeriodBase in Future-DB.
+
+    CPendingTable _m_pending_;           // In-flight commands in NOW-space. (NOW-DB is durable copy of it.)
+
+    CRetryEngine _m_retry_;              // Timeout & Re-sending of in-flight commands.
+
+    CPeerSender _m_sender_;              // Send-queue per peer.
+
     /* Thread Routin variables */
     std::atomic<bool> _m_is_continue_;
 
-    std::thread _mt_rcmd_handler_;       // Store of Received CMD. (Rx)
+    std::vector<std::thread> _mv_rcmd_handlers_;    // Store of Received CMD. (Rx, a thread per shard)
 
     std::thread _mt_scmd_handler_;       // Trig of Send CMD. (Tx)
 
-    /** Blocking Queue for received CMDs */
-    std::mutex _mtx_queue_lock_;
-    std::condition_variable _m_queue_cv_;
-    std::queue<std::shared_ptr<cmd::ICommand>> _mv_cmds_;
+    std::thread _mt_db_writer_;          // Writer of NOW/PAST-DB.
+
+    std::thread _mt_retry_handler_;      // Timeout handler of in-flight commands.
+
+    /** Blocking Queues for received CMDs sharded by peer. (Multi-Producer: communicators, Single-Consumer: RX-thread) */
+    std::vector<std::shared_ptr<TCMDqueue>> _mv_cmds_;
 
-    /** Send CMD */
-    std::mutex _mtx_send_lock_;
+    /** Job Queue for DB-writer */
+    std::mutex _mtx_db_jobs_;
+    std::condition_variable _m_db_jobs_cv_;
+    std::queue<TdbJob> _mv_db_jobs_;
+    bool _m_is_db_writing_;
 
 };
 
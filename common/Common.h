@@ -38,6 +38,8 @@ typedef enum E_STATE {
     /** for announcing System/Task Error */
     E_STATE_OCCURE_ERROR    = 0x0040,   // [Global-Set] If Unintended-System Error is occured, then this state set.
     E_STATE_ACTION_FAIL     = 0x0080,   // [Global-Set] 0: not exist means  , 1: fail with action
+
+    E_STATE_BODY_BINARY     = 0x0100,   // [KeepAlive ] Sender accepts binary-body of CMD. (0: only json, 1: json & binary)
     
     /** for reaction-sending corresponded with TASK */
     E_STATE_REACT_ACTION_START  = 0x1000,   // [Internal-Use] It need to send ACTION-START packet to peer.
@@ -0,0 +1,70 @@
+#include <ctime>
+#include <random>
+#include <stdexcept>
+
+#include <logger.h>
+#include <CuCMD/CMsgIdAllocator.h>
+
+namespace cmd {
+
+constexpr uint32_t CMsgIdAllocator::MSG_ID_NULL;
+constexpr uint32_t CMsgIdAllocator::EPOCH_BITS;
+constexpr uint32_t CMsgIdAllocator::COUNTER_BITS;
+constexpr uint32_t CMsgIdAllocator::COUNTER_MASK;
+
+
+/*********************************
+ * Definition of Public Function.
+ */
+CMsgIdAllocator& CMsgIdAllocator::get_instance(void) {
+    static CMsgIdAllocator instance;
+    return instance;
+}
+
+uint32_t CMsgIdAllocator::allocate(void) {
+    std::lock_guard<std::mutex> guard(_mtx_registry_);
+    return next_unlocked();
+}
+
+bool CMsgIdAllocator::reserve( uint32_t msg_id ) {
+    if( msg_id == MSG_ID_NULL ) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> guard(_mtx_registry_);
+    return _m_registry_.insert( msg_id ).second;
+}
+
+bool CMsgIdAllocator::release( uint32_t msg_id ) {
+    std::lock_guard<std::mutex> guard(_mtx_registry_);
+    return _m_registry_.erase( msg_id ) > 0;
+}
+
+
+/*********************************
+ * Definition of Private Function.
+ */
+CMsgIdAllocator::CMsgIdAllocator(void) {
+    std::random_device rd;
+    std::mt19937 gen( rd() ^ static_cast<uint32_t>(time(NULL)) );
+
+    _m_epoch_ = gen() & ((1u << EPOCH_BITS) - 1);
+    _m_counter_ = gen() & COUNTER_MASK;
+    LOGI("MSG-ID allocator is seeded. (epoch=0x%02X)", _m_epoch_);
+}
+
+uint32_t CMsgIdAllocator::next_unlocked(void) {
+    for( uint32_t tries=0; tries <= COUNTER_MASK; tries++ ) {
+        _m_counter_ = (_m_counter_ + 1) & COUNTER_MASK;
+        uint32_t msg_id = (_m_epoch_ << COUNTER_BITS) | _m_counter_;
+
+        if( msg_id != MSG_ID_NULL && _m_registry_.find(msg_id) == _m_registry_.end() ) {
+            return msg_id;
+        }
+    }
+
+    throw std::overflow_error("All of msg-ids are in-flight.");
+}
+
+
+}   // namespace cmd
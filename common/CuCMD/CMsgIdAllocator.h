@@ -0,0 +1,65 @@
+#ifndef _CLASS_MSG_ID_ALLOCATOR_H_
+#define _CLASS_MSG_ID_ALLOCATOR_H_
+
+#include <mutex>
+#include <cstdint>
+#include <unordered_set>
+
+namespace cmd {
+
+
+/***
+ * Per-process allocator of msg-id. (It's seeded once at first use.)
+ *  - msg-id = [epoch : 7 bits][counter : 24 bits] (1 ~ 0x7FFFFFFF, because peer decodes it as signed int.)
+ *    Epoch is random per process, so msg-ids of previous run (Ex: in-flight rows of NOW-DB) are not replayed.
+ *  - Registry of in-flight msg-ids : allocate() skips msg-id that is still registered,
+ *    so response of old request can not be matched to new request.
+ ***/
+class CMsgIdAllocator {
+public:
+    static constexpr uint32_t MSG_ID_NULL = 0;
+    static constexpr uint32_t EPOCH_BITS = 7;
+    static constexpr uint32_t COUNTER_BITS = 24;
+    static constexpr uint32_t COUNTER_MASK = (1u << COUNTER_BITS) - 1;
+
+public:
+    static CMsgIdAllocator& get_instance(void);
+
+    /** New msg-id that is not in-flight. (It's not registered.) */
+    uint32_t allocate(void);
+
+    /** Register msg-id as in-flight. (Ex: loaded from NOW-DB) return false, if it's already registered. */
+    bool reserve( uint32_t msg_id );
+
+    /** return false, if msg-id is not registered. */
+    bool release( uint32_t msg_id );
+
+    uint32_t get_epoch(void) const { return _m_epoch_; }
+
+private:
+    CMsgIdAllocator(void);
+
+    CMsgIdAllocator(const CMsgIdAllocator&) = delete;             // copy constructor
+    CMsgIdAllocator& operator=(const CMsgIdAllocator&) = delete;  // copy operator
+    CMsgIdAllocator(CMsgIdAllocator&&) = delete;                  // move constructor
+    CMsgIdAllocator& operator=(CMsgIdAllocator&&) = delete;       // move operator
+
+    /** It must be called in lock of _mtx_registry_. */
+    uint32_t next_unlocked(void);
+
+private:
+    uint32_t _m_epoch_;
+
+    uint32_t _m_counter_;
+
+    std::unordered_set<uint32_t> _m_registry_;    // in-flight msg-ids
+
+    std::mutex _mtx_registry_;
+
+};
+
+
+}   // namespace cmd
+
+
+#endif // _CLASS_MSG_ID_ALLOCATOR_H_
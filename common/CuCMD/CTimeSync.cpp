@@ -340,6 +340,8 @@ void CTimeSync::update_keepalive(std::shared_ptr<CuCMD> cmd) {
             target.alias->set_state(::common::E_STATE::E_STATE_TIME_ON, value);
             value = (state & ::common::E_STATE::E_STATE_TIME_SRC) != 0 ? true : false;
             target.alias->set_state(::common::E_STATE::E_STATE_TIME_SRC, value);
+            value = (state & ::common::E_STATE::E_STATE_BODY_BINARY) != 0 ? true : false;
+            target.alias->set_state(::common::E_STATE::E_STATE_BODY_BINARY, value);
         }
 
         // check state & trig update_time proc.
@@ -359,6 +361,17 @@ void CTimeSync::update_keepalive(std::shared_ptr<CuCMD> cmd) {
 }
 
 
+common::StateType CTimeSync::get_peer_state(const std::string& app, const std::string& pvd, common::E_STATE pos) {
+    std::lock_guard<std::mutex>  guard(_mtx_peers_);
+    auto itr = _mm_peers_.find( alias_full_path(app, pvd) );
+    if( itr == _mm_peers_.end() ) {
+        return ::common::E_STATE::E_NO_STATE;
+    }
+
+    return itr->second.alias->get_state(pos);
+}
+
+
 /**********************************
  * Definition of Private Function.
  */
@@ -81,6 +81,9 @@ public:
     /* When received keepalive-msg, this function will be called. */
     void update_keepalive(std::shared_ptr<CuCMD> cmd);
 
+    /* State of peer that is announced by keepalive-msg. (0, if peer is not connected.) */
+    common::StateType get_peer_state(const std::string& app, const std::string& pvd, common::E_STATE pos);
+
 private:
     CTimeSync( void ) = delete;
 
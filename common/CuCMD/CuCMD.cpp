@@ -1,5 +1,5 @@
 #include <cassert>
-#include <random>
+#include <cstdlib>
 #include <memory>
 #include <iostream>
 #include <string.h>
@@ -10,6 +10,8 @@
 #include <IProtocolInf.h>
 #include <Common.h>
 #include <time_kes.h>
+#include <CPrincipleReader.h>
+#include <CuCMD/CMsgIdAllocator.h>
 
 
 namespace cmd {
@@ -17,6 +19,9 @@ namespace cmd {
 
 constexpr const char* CuCMD::NAME;
 constexpr const char* CuCMD::PROTOCOL_NAME;
+constexpr const char* CuCMD::ENV_BODY_ENCODING;
+constexpr const char* CuCMD::BODY_JSON;
+constexpr const char* CuCMD::BODY_BINARY;
 
 
 /**********************************
@@ -31,7 +36,7 @@ CuCMD::CuCMD( alias::CAlias& myself, FlagType flag_val)
 : ICommand( myself, flag_val ) {
     clear();
 
-    _msg_id_ = gen_random_msg_id();
+    _msg_id_ = gen_msg_id();
     _flag_ = flag_val;
     _state_ = 0;
 }
@@ -47,12 +52,7 @@ CuCMD::CuCMD( const CuCMD& cmd )
     _msg_id_ = cmd._msg_id_;
     _send_time_d_ = cmd._send_time_d_;
     
-    _who_ = cmd._who_;
-    _when_ = cmd._when_;
-    _where_ = cmd._where_;
-    _what_ = cmd._what_;
-    _how_ = cmd._how_;
-    _why_ = cmd._why_;
+    copy_sections( cmd );
     this->set_flag_parse( cmd.is_parsed(), cmd.get_rcv_time() );
 }
 
@@ -84,30 +84,16 @@ bool CuCMD::decode(std::shared_ptr<IProtocolInf>& protocol) {
 
             if( get_flag(E_FLAG::E_FLAG_KEEPALIVE) == 0 ) {
                 if( payload != NULL && payload_size > 0 ) {
-                    // parsing json payload (where, what, how, why)
-                    Json_DataType json_manager;
-                    json_manager = std::make_shared<json_mng::CMjson>();
+                    // keep json payload. (who, when, where, what, how, why are decoded at first access.)
+                    // So, ACK/START/DONE & control messages are processed without json-parsing.
                     LOGD("payload=%s , length=%d", payload, payload_size);
-                    if( json_manager->parse(payload, payload_size) != true) {
-                        throw std::runtime_error("Invalid json-payload. please check it.");
-                    }
-                    _payload_ = std::string( json_manager->print_buf() );
-                    LOGD("_payload_=%s", _payload_.data());
-
-                    // check UniversalCMD version.
-                    auto ver = extract_version(json_manager);
-                    if( ver != version() ) {
-                        std::string err = "VERSION(" + ver + ") of json-context != " + version();
-                        throw std::invalid_argument(err);
+                    reset_sections();
+                    set_raw_payload( payload, payload_size );
+
+                    // reject malformed CMD before any principle-6 object is built.
+                    if( validate_payload() == false ) {
+                        return false;
                     }
-                    // parse principle-6.
-                    _who_ = extract_who(json_manager);
-                    _when_ = extract_when(json_manager, _send_time_d_);
-                    _where_ = extract_where(json_manager);
-                    _what_ = extract_what(json_manager);
-                    _how_ = extract_how(json_manager);
-                    _why_ = extract_why(json_manager);
-                    LOGD( "Success parse of Json buffer." );
                 }
             }
 
@@ -118,6 +104,7 @@ bool CuCMD::decode(std::shared_ptr<IProtocolInf>& protocol) {
     catch ( const std::exception& e ) {
         LOGERR("%s", e.what());
         _payload_.clear();
+        reset_sections();
         throw CException(E_ERROR::E_ERR_FAIL_DECODING_CMD);
     }
 
@@ -154,27 +141,38 @@ std::shared_ptr<payload::CPayload> CuCMD::encode( std::shared_ptr<ICommunicator>
         protocol->set_property("state", _state_);
         protocol->set_property("msg_id", _msg_id_);
 
+        decode_sections();
         if ( _who_.get() != NULL && _when_.get() != NULL && _where_.get() != NULL && 
              _what_.get() != NULL && _how_.get() != NULL && _why_.get() != NULL ) {
             const char* body = NULL;
             Json_DataType json_manager;
-            LOGD("Try to make payload using JSON-format.");
-
-            // make json body (where, what, how, why)
-            json_manager = std::make_shared<json_mng::CMjson>();
-            assert( json_manager.get() != NULL );
-            // set UniversalCMD version.
-            assert(apply_version(json_manager) == true);
-            // set principle-6.
-            assert(apply_who(json_manager, _who_) == true);
-            assert(apply_when(json_manager, _when_) == true);
-            assert(apply_where(json_manager, _where_) == true);
-            assert(apply_what(json_manager, _what_) == true);
-            assert(apply_how(json_manager, _how_) == true);
-            assert(apply_why(json_manager, _why_) == true);
-            assert( (body = json_manager->print_buf()) != NULL );
-
-            protocol->set_payload( body, strlen(body) );
+            std::string payload;
+
+            // binary-body is built from sections directly. (json-text is not made.)
+            if( _is_peer_binary_ == true && is_binary_body() == true &&
+                principle::CPrincipleReader::to_binary( version(), *_who_, *_when_, *_where_, *_what_, *_how_, *_why_, payload ) == true ) {
+                LOGD("Make payload using binary-body. (%zu bytes)", payload.length());
+            }
+            else {
+                LOGD("Try to make payload using JSON-format.");
+
+                // make json body (where, what, how, why)
+                json_manager = std::make_shared<json_mng::CMjson>();
+                assert( json_manager.get() != NULL );
+                // set UniversalCMD version.
+                assert(apply_version(json_manager) == true);
+                // set principle-6.
+                assert(apply_who(json_manager, _who_) == true);
+                assert(apply_when(json_manager, _when_) == true);
+                assert(apply_where(json_manager, _where_) == true);
+                assert(apply_what(json_manager, _what_) == true);
+                assert(apply_how(json_manager, _how_) == true);
+                assert(apply_why(json_manager, _why_) == true);
+                assert( (body = json_manager->print_buf()) != NULL );
+                payload = body;
+            }
+
+            protocol->set_payload( payload.c_str(), payload.length() );
         }
     }
     catch ( const std::exception& e ) {
@@ -189,7 +187,8 @@ std::shared_ptr<payload::CPayload> CuCMD::encode( std::shared_ptr<ICommunicator>
 
 std::shared_ptr<payload::CPayload> CuCMD::force_encode( std::shared_ptr<ICommunicator>& handler, 
                                                         std::string payload, 
-                                                        FlagType flag, common::StateType state, uint32_t& msg_id ) {
+                                                        FlagType flag, common::StateType state, uint32_t& msg_id,
+                                                        bool peer_binary ) {
     std::shared_ptr<payload::CPayload> message;
     std::shared_ptr<IProtocolInf> protocol;
 
@@ -205,7 +204,7 @@ std::shared_ptr<payload::CPayload> CuCMD::force_encode( std::shared_ptr<ICommuni
         }
         protocol = message->get(PROTOCOL_NAME);
         if( msg_id == 0 ) {
-            msg_id = gen_random_msg_id();
+            msg_id = gen_msg_id();
         }
     
         // Check ab-normal state & set flag
@@ -221,6 +220,9 @@ std::shared_ptr<payload::CPayload> CuCMD::force_encode( std::shared_ptr<ICommuni
         LOGI("flag=0x%X", flag);
         if( payload.empty() == false ) {
             LOGI("payload=%s", payload.data());
+            if( (flag & E_FLAG::E_FLAG_KEEPALIVE) == 0 && peer_binary == true ) {
+                apply_body_encoding( payload );
+            }
             protocol->set_payload( payload.c_str(), payload.length() );
         }
     }
@@ -244,7 +246,7 @@ CuCMD::FlagType CuCMD::get_flag(FlagType pos) {
 void CuCMD::set_id(uint32_t value) { 
     _msg_id_ = value;
     if( _msg_id_ == 0 ) {
-        _msg_id_ = gen_random_msg_id();
+        _msg_id_ = gen_msg_id();
     }
 }
 
@@ -296,32 +298,48 @@ void CuCMD::clear(void) {
     _flag_ = E_FLAG::E_FLAG_NONE;
     _state_ = 0;
     _send_time_d_ = 0.0;
+    _is_peer_binary_ = false;
 
-    _who_.reset();
-    _when_.reset();
-    _where_.reset();
-    _what_.reset();
-    _how_.reset();
-    _why_.reset();
+    reset_sections();
     set_flag_parse(false);
 }
 
-uint32_t CuCMD::gen_random_msg_id(void) {
-    uint32_t new_msgid = 0;
-    int32_t id_min = 1;
-    int32_t id_max = 2147483647;
-    std::random_device rd;  //Will be used to obtain a seed for the random number engine
-    std::mt19937 gen( rd() ); 
-    std::uniform_int_distribution<> dist(id_min, id_max); 
-    
-    LOGD("Random MSG-ID Min : %d", (uint32_t)(dist.min()) );
-    LOGD("Random MSG-ID Max : %d", (uint32_t)(dist.max()) );
+bool CuCMD::is_binary_body(void) {
+    static const bool is_binary = [](void) -> bool {
+        const char* value = getenv(ENV_BODY_ENCODING);
+        bool result = false;
 
-    new_msgid = (uint32_t)(dist( gen ));
-    assert( ((uint32_t)id_min) <= new_msgid && new_msgid <= ((uint32_t)id_max) );
-    LOGI("Generated new MSG-ID=%d", new_msgid);
+        if( value != NULL ) {
+            if( strcmp(value, BODY_BINARY) == 0 ) {
+                result = true;
+            }
+            else if( strcmp(value, BODY_JSON) != 0 ) {
+                LOGW("%s(%s) is invalid. (valid values: %s, %s)", ENV_BODY_ENCODING, value, BODY_JSON, BODY_BINARY);
+            }
+        }
+
+        LOGI("CMD body-encoding = %s", (result ? BODY_BINARY : BODY_JSON));
+        return result;
+    }();
+
+    return is_binary;
+}
+
+void CuCMD::apply_body_encoding( std::string& body ) {
+    std::string binary;
+
+    if( is_binary_body() == false || principle::CPrincipleReader::is_binary(body.c_str(), body.length()) == true ) {
+        return;
+    }
+
+    if( principle::CPrincipleReader::to_binary(body.c_str(), body.length(), binary) == true ) {
+        LOGD("body is encoded to binary. (%zu -> %zu bytes)", body.length(), binary.length());
+        body.swap( binary );
+    }
+}
 
-    return new_msgid;
+uint32_t CuCMD::gen_msg_id(void) {
+    return CMsgIdAllocator::get_instance().allocate();
 }
 
 
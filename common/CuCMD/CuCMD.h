@@ -23,6 +23,15 @@ public:
     static constexpr const char* NAME = "uCMD";
     static constexpr const char* PROTOCOL_NAME = "CPUniversalCMD";
 
+    /***
+     * Encoding of body for sending. (Receiver detects it by first byte of body, so both are always accepted.)
+     * Binary-body is sent only to peer that announced E_STATE_BODY_BINARY by KEEPALIVE.
+     * Others (Ex: peer that is not upgraded, or before first KEEPALIVE) receive json-body.
+     ***/
+    static constexpr const char* ENV_BODY_ENCODING = "CUCMD_BODY_ENCODING";
+    static constexpr const char* BODY_JSON = "json";        // default
+    static constexpr const char* BODY_BINARY = "binary";    // binary-body of principle::CPrincipleReader
+
 public:
     CuCMD(std::string my_app_path, std::string my_pvd_id);
 
@@ -43,7 +52,8 @@ public:
 
     static std::shared_ptr<payload::CPayload> force_encode( std::shared_ptr<ICommunicator>& handler, 
                                                             std::string payload, 
-                                                            FlagType flag, common::StateType state, uint32_t& msg_id );
+                                                            FlagType flag, common::StateType state, uint32_t& msg_id,
+                                                            bool peer_binary=false );
 
     // getter
     uint32_t get_id(void) override { return _msg_id_; }
@@ -61,13 +71,27 @@ public:
 
     void set_state(uint16_t value);
 
+    /** Receiver of encode() accepts binary-body. (See ENV_BODY_ENCODING) */
+    void set_peer_binary(bool value) { _is_peer_binary_ = value; }
+
     // printer
     std::string print_send_time(void);  // print when-data for human-readable.
 
+    /** New msg-id that is not in-flight. (See CMsgIdAllocator) */
+    static uint32_t gen_msg_id(void);
+
+protected:
+    /** 'when' of payload is based on send-time of sender. */
+    double get_default_time(void) const override { return _send_time_d_; }
+
 private:
     void clear(void);
 
-    static uint32_t gen_random_msg_id(void);
+    /** Read ENV_BODY_ENCODING once. */
+    static bool is_binary_body(void);
+
+    /** Convert json-body to binary-body, if it's enabled. (Body that can not be converted is kept as json.) */
+    static void apply_body_encoding( std::string& body );
 
 private:
     // Data-Structure for Decoded packet.
@@ -80,6 +104,8 @@ private:
     // send/receive time
     double _send_time_d_;       // UTC time with nano-seconds.
 
+    bool _is_peer_binary_;      // only for encode().
+
 };
 
 
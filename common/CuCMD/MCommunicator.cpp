@@ -1,5 +1,4 @@
 #include <cassert>
-#include <iostream>
 
 #include <stdio.h>
 #include <unistd.h>
@@ -15,6 +14,8 @@ using namespace std::placeholders;
 namespace comm {
 
 constexpr const double MCommunicator::MAX_HOLD_TIME;
+constexpr const double MCommunicator::REQ_HISTORY_HOLD_TIME;
+constexpr const size_t MCommunicator::LISTEN_QUEUE_SIZE;
 
 /*********************************
  * Definition of Public Function.
@@ -22,7 +23,8 @@ constexpr const double MCommunicator::MAX_HOLD_TIME;
 MCommunicator::MCommunicator( const std::string& app_path, 
                               std::string& file_path_alias, 
                               const TProtoMapper& mapper_pvd_proto,
-                              const double max_holding_time ) {
+                              const double max_holding_time )
+: _m_listen_jobs_(LISTEN_QUEUE_SIZE), _m_listen_dropped_(0) {
     clear();
     try {
         _m_myself_ = std::make_shared<alias::CAlias>( app_path, "ALL-PVDs", true );
@@ -51,6 +53,7 @@ MCommunicator::MCommunicator( const std::string& app_path,
 }
 
 MCommunicator::~MCommunicator(void) {
+    stop_listeners();
     clear();
 }
 
@@ -88,6 +91,11 @@ std::shared_ptr<alias::CAlias> MCommunicator::get_myself(void) {
 
 void MCommunicator::start( void ) {
     try {
+        if( _mt_listener_.joinable() == false ) {
+            LOGI("Create Listener-thread. (queue-capacity=%zu)", _m_listen_jobs_.capacity());
+            _mt_listener_ = std::thread(&MCommunicator::run_listeners, this);
+        }
+
         for( auto itr=_mm_comm_.begin(); itr != _mm_comm_.end(); itr++ ) {
             LOGI("Start pvd-id(%s) instance.", itr->first.data());
             itr->second->init();
@@ -126,7 +134,7 @@ uint32_t MCommunicator::keepalive( const alias::CAlias& peer, const std::string&
         std::shared_ptr<payload::CPayload> new_payload;
 
         // Search communicators that is connected with peer.
-        std::shared_ptr<TCommList> comms_list = get_comms( peer_app, peer_pvd, proto );
+        std::shared_ptr<const TCommList> comms_list = get_comms( peer_app, peer_pvd, proto );
         if( comms_list.get() == NULL ) {
             throw std::runtime_error("TCommList memory-allocation is failed.");
         }
@@ -146,6 +154,7 @@ uint32_t MCommunicator::keepalive( const alias::CAlias& peer, const std::string&
         // Set flag & state variables
         flag |= E_FLAG::E_FLAG_KEEPALIVE;    // set KEEPALIVE message flag.
         state |= ::common::E_STATE::E_STATE_THR_KEEPALIVE;
+        state |= ::common::E_STATE::E_STATE_BODY_BINARY;     // announce that binary-body is accepted.
         state |= _m_myself_->get_state(E_STATE::E_STATE_ALL);
 
         // Force-encode to packet.
@@ -169,9 +178,8 @@ uint32_t MCommunicator::keepalive( const alias::CAlias& peer, const std::string&
 }
 
 /* return value: msg-id if sending req-msg is failed, then msg-id == 0, vice verse msg-id != 0  */
-uint32_t MCommunicator::request( const alias::CAlias& peer, const std::string& json_cmd, common::StateType state, bool require_resp ) {
-    uint32_t msg_id = 0;
-
+uint32_t MCommunicator::request( const alias::CAlias& peer, const std::string& json_cmd, common::StateType state, 
+                                 bool require_resp, uint32_t msg_id ) {
     try {
         cmd::ICommand::FlagType flag = E_FLAG::E_FLAG_NONE;
         CommHandler handler;
@@ -181,7 +189,7 @@ uint32_t MCommunicator::request( const alias::CAlias& peer, const std::string& j
         std::shared_ptr<payload::CPayload> new_payload;
 
         // Search communicators that is connected with peer.
-        std::shared_ptr<TCommList> comms_list = get_comms( peer_app, peer_pvd, proto );
+        std::shared_ptr<const TCommList> comms_list = get_comms( peer_app, peer_pvd, proto );
         if( comms_list.get() == NULL ) {
             throw std::runtime_error("TCommList memory-allocation is failed.");
         }
@@ -207,7 +215,7 @@ uint32_t MCommunicator::request( const alias::CAlias& peer, const std::string& j
         state |= _m_myself_->get_state(E_STATE::E_STATE_ALL);
 
         // Force-encode to packet.
-        new_payload = cmd::CuCMD::force_encode( handler, json_cmd, flag, state, msg_id );
+        new_payload = cmd::CuCMD::force_encode( handler, json_cmd, flag, state, msg_id, is_binary_peer(peer_app, peer_pvd) );
         if( new_payload.get() == NULL ) {
             LOGERR("Encoding message is failed for peer(%s/%s) & proto(%s)", peer_app.data(), peer_pvd.data(), proto.data() );
             throw CException(E_ERROR::E_ERR_FAIL_ENCODING_CMD);
@@ -234,6 +242,11 @@ bool MCommunicator::notify_action_done( const alias::CAlias& peer, unsigned long
     return send_without_payload(peer, E_FLAG::E_FLAG_RESP_MSG, msg_id, state);
 }
 
+bool MCommunicator::notify_action_fail( const alias::CAlias& peer, unsigned long msg_id, E_STATE state ) {
+    // ACTION_FAIL state makes STATE_ERROR flag in encoding, so it's recorded as FAIL by peer.
+    return send_without_payload(peer, E_FLAG::E_FLAG_RESP_MSG, msg_id, static_cast<E_STATE>(state | E_STATE::E_STATE_ACTION_FAIL));
+}
+
 
 
 /*********************************
@@ -246,6 +259,7 @@ void MCommunicator::clear( void ) {
     _m_alias_searcher_.reset();
     _mm_comm_.clear();
     _mm_listener_.clear();
+    invalidate_routes();
 }
 
 void MCommunicator::init( std::map<std::string, TPvdList>& pvd_mapper, const std::string& alias_file_path, 
@@ -320,7 +334,21 @@ void MCommunicator::init_keepalive( std::string& pvd_id, std::list<std::string>&
     }
 }
 
-std::shared_ptr<MCommunicator::TCommList> MCommunicator::get_comms( const std::string& peer_app, const std::string& peer_pvd, std::string proto_name ) {
+std::shared_ptr<const MCommunicator::TCommList> MCommunicator::get_comms( const std::string& peer_app, const std::string& peer_pvd, const std::string& proto_name ) {
+    std::string key = peer_app + "/" + peer_pvd + "@" + proto_name;
+    std::lock_guard<std::mutex> guard(_mtx_routes_);
+
+    auto itr = _mm_routes_.find( key );
+    if( itr != _mm_routes_.end() ) {
+        return itr->second;
+    }
+
+    auto comms_list = search_comms( peer_app, peer_pvd, proto_name );
+    _mm_routes_[key] = comms_list;
+    return comms_list;
+}
+
+std::shared_ptr<const MCommunicator::TCommList> MCommunicator::search_comms( const std::string& peer_app, const std::string& peer_pvd, const std::string& proto_name ) {
     std::shared_ptr<TCommList> comms_list;
 
     try {
@@ -355,6 +383,15 @@ std::shared_ptr<MCommunicator::TCommList> MCommunicator::get_comms( const std::s
     return comms_list;
 }
 
+void MCommunicator::invalidate_routes( void ) {
+    std::lock_guard<std::mutex> guard(_mtx_routes_);
+    _mm_routes_.clear();
+}
+
+bool MCommunicator::is_binary_peer( const std::string& peer_app, const std::string& peer_pvd ) {
+    return _m_time_synchor_->get_peer_state( peer_app, peer_pvd, E_STATE::E_STATE_BODY_BINARY ) != 0;
+}
+
 void MCommunicator::apply_sys_state(std::shared_ptr<::cmd::CuCMD>& cmd, common::StateType state) {
     try {
         if( cmd.get() == NULL ) {
@@ -383,7 +420,7 @@ bool MCommunicator::send( std::shared_ptr<CMDType> &cmd ) {
         std::shared_ptr<payload::CPayload> new_payload;
 
         // Search communicators that is connected with peer.
-        std::shared_ptr<TCommList> comms_list = get_comms( peer_app, peer_pvd, proto );
+        std::shared_ptr<const TCommList> comms_list = get_comms( peer_app, peer_pvd, proto );
         if( comms_list.get() == NULL ) {
             throw std::runtime_error("TCommList memory-allocation is failed.");
         }
@@ -400,7 +437,11 @@ bool MCommunicator::send( std::shared_ptr<CMDType> &cmd ) {
         }
         handler = *comms_list->begin();
 
-        // Encode cmd to packet.
+        // Encode cmd to packet. (binary-body is used only for peer that accepts it.)
+        auto ucmd = std::dynamic_pointer_cast<cmd::CuCMD>(cmd);
+        if( ucmd.get() != NULL ) {
+            ucmd->set_peer_binary( is_binary_peer(peer_app, peer_pvd) );
+        }
         new_payload = cmd->encode( handler );
         if( new_payload.get() == NULL ) {
             LOGERR("Encoding message is failed for peer(%s/%s) & proto(%s)", peer_app.data(), peer_pvd.data(), proto.data() );
@@ -442,7 +483,7 @@ void MCommunicator::send_ack( std::string& pvd_id , std::shared_ptr<CMDType>& rc
 bool MCommunicator::send_without_payload( const alias::CAlias& peer, E_FLAG flag, unsigned long msg_id, E_STATE state) {
     bool result = true;
     try {
-        std::shared_ptr<TCommList> comms_list = get_comms( peer.app_path, peer.pvd_id, cmd::CuCMD::PROTOCOL_NAME );
+        std::shared_ptr<const TCommList> comms_list = get_comms( peer.app_path, peer.pvd_id, cmd::CuCMD::PROTOCOL_NAME );
         if( comms_list.get() == NULL ) {
             throw std::runtime_error("TCommList memory-allocation is failed.");
         }
@@ -452,7 +493,8 @@ bool MCommunicator::send_without_payload( const alias::CAlias& peer, E_FLAG flag
         }
 
         for( auto itr = comms_list->begin(); itr != comms_list->end(); itr++ ) {
-            if( send_without_payload( peer, flag, msg_id, *itr, state) == false ) {
+            CommHandler comm = *itr;
+            if( send_without_payload( peer, flag, msg_id, comm, state) == false ) {
                 LOGERR("send_without_payload is failed. (peer: %s/%s:%u)", peer.app_path.data(), peer.pvd_id.data(), msg_id);
                 result = false;
             }
@@ -515,6 +557,41 @@ bool MCommunicator::send_without_payload( const alias::CAlias& peer,
     return false;
 }
 
+bool MCommunicator::dispatch_listeners( std::string& pvd_id, std::shared_ptr<CMDType>& rcmd ) {
+    if( _m_listen_jobs_.push( std::make_pair(pvd_id, rcmd) ) == false ) {
+        size_t dropped = _m_listen_dropped_.fetch_add(1) + 1;
+        LOGW("Listener-queue is saturated. (depth=%zu, capacity=%zu, dropped=%zu)", 
+             _m_listen_jobs_.depth(), _m_listen_jobs_.capacity(), dropped);
+        return false;
+    }
+    return true;
+}
+
+void MCommunicator::run_listeners( void ) {
+    TListenJob job;
+
+    LOGI("Listener-thread is started.");
+    while( _m_listen_jobs_.wait_pop( job ) == true ) {
+        try {
+            call_listeners( job.first, job.second );
+        }
+        catch ( const std::exception& e ) {
+            LOGERR("Listener of pvd(%s) is failed: %s", job.first.data(), e.what());
+        }
+        job.second.reset();
+    }
+    LOGI("Listener-thread is stopped.");
+}
+
+void MCommunicator::stop_listeners( void ) {
+    _m_listen_jobs_.stop();
+    if( _mt_listener_.joinable() == true ) {
+        _mt_listener_.join();
+        LOGI("Listener-queue: depth=%zu, high-water=%zu, capacity=%zu, dropped=%zu", _m_listen_jobs_.depth(), 
+             _m_listen_jobs_.high_water(), _m_listen_jobs_.capacity(), _m_listen_dropped_.load());
+    }
+}
+
 void MCommunicator::call_listeners( std::string& pvd_id, std::shared_ptr<CMDType>& rcmd ) {
     try {
         auto itr = _mm_listener_.find(pvd_id);
@@ -548,6 +625,9 @@ void MCommunicator::cb_initialization(enum_c::ProviderType provider_type, bool f
 
 void MCommunicator::cb_connected(std::string peer_app, std::string peer_pvd, bool flag_connect, std::string pvd_id) {
     try {
+        // Routes are searched again at next sending, because connections are changed.
+        invalidate_routes();
+
         if( _mm_keepalive_enabled_pvds_.find(pvd_id) == _mm_keepalive_enabled_pvds_.end() ) {
             LOGW("\"%s\" is provider-ID that KEEPALIVE function is disabled.", pvd_id.data());
             return ;
@@ -572,11 +652,7 @@ void MCommunicator::cb_receive_msg_handle(std::string peer_app, std::string peer
                                           std::shared_ptr<payload::CPayload> payload, std::string pvd_id) {
     try {
         std::string proto_name = payload->get_name();
-
-        std::cout << "************************************" << std::endl;
-        std::cout << "* 1. Peer-ID : " << peer_app << "/" << peer_pvd << std::endl;
-        std::cout << "* 2. CPayload-Name : " << proto_name << std::endl;
-        std::cout << "************************************" << std::endl;
+        LOGD("Receive message. (peer=%s/%s, proto=%s)", peer_app.data(), peer_pvd.data(), proto_name.data());
 
         std::shared_ptr<CMDType> rcmd;
         std::shared_ptr<IProtocolInf> protocol = payload->get(proto_name);
@@ -589,9 +665,10 @@ void MCommunicator::cb_receive_msg_handle(std::string peer_app, std::string peer
         }
         
         // Parsing of received-CMD.
+        // Invalid CMD is dropped here without exception. (reason is logged by decode())
         if( rcmd->decode( protocol ) == false ) {
-            std::string err = "Decoding message is failed. (peer=" + peer_app + "/" + peer_pvd + ", proto=" + proto_name + ")";
-            throw std::logic_error(err);
+            LOGW("Decoding message is failed. (peer=%s/%s, proto=%s)", peer_app.data(), peer_pvd.data(), proto_name.data());
+            return ;
         }
 
         // Processing received KEEPALIVE msg.
@@ -609,7 +686,18 @@ void MCommunicator::cb_receive_msg_handle(std::string peer_app, std::string peer
             throw std::out_of_range("All-Service are out-of-service state.");
         }
 
-        call_listeners(pvd_id, rcmd);
+        // Request that is re-sent by peer (because ACK is lost) is ACKed again without calling listeners.
+        if( is_duplicated_request( rcmd ) == true ) {
+            send_ack( pvd_id , rcmd );
+            throw std::out_of_range("Duplicated request(msg-id=" + std::to_string(rcmd->get_id()) + ") is received. Re-send ACK only.");
+        }
+
+        // Listeners are called by listener-thread, so ACK is not delayed by slow listener.
+        // If listener-queue is saturated, ACK is not sent and peer re-sends the request later.
+        if( dispatch_listeners(pvd_id, rcmd) == false ) {
+            forget_request( rcmd );
+            throw std::out_of_range("Request(msg-id=" + std::to_string(rcmd->get_id()) + ") is dropped without ACK.");
+        }
         send_ack( pvd_id , rcmd );  // Send ACK message to peer.
     }
     catch ( const std::out_of_range& e ) {
@@ -620,6 +708,34 @@ void MCommunicator::cb_receive_msg_handle(std::string peer_app, std::string peer
     }
 }
 
+bool MCommunicator::is_duplicated_request( std::shared_ptr<CMDType>& rcmd ) {
+    bool value = false;
+    TReqHistory::TVentry expired;
+
+    if( (bool)(rcmd->get_flag(E_FLAG::E_FLAG_REQUIRE_ACK)) == false || rcmd->get_id() == 0 ) {
+        return false;
+    }
+
+    // Remove old history, then check whether same request is received already.
+    _m_req_history_.pop_due( expired );
+
+    std::string key = get_request_key( rcmd );
+    if( _m_req_history_.find( key, value ) == true ) {
+        return true;
+    }
+
+    _m_req_history_.push( key, TReqHistory::now() + REQ_HISTORY_HOLD_TIME, true );
+    return false;
+}
+
+void MCommunicator::forget_request( std::shared_ptr<CMDType>& rcmd ) {
+    _m_req_history_.remove( get_request_key(rcmd) );
+}
+
+std::string MCommunicator::get_request_key( std::shared_ptr<CMDType>& rcmd ) {
+    return rcmd->get_from().app_path + "/" + rcmd->get_from().pvd_id + "@" + std::to_string(rcmd->get_id());
+}
+
 void MCommunicator::cb_abnormally_quit(const std::exception &e, std::string pvd_id) {
     LOGERR("pvd-id=%s: %s", pvd_id.data(), e.what());
 }
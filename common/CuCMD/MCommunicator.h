@@ -3,6 +3,7 @@
 
 #include <map>
 #include <list>
+#include <unordered_map>
 #include <string>
 #include <thread>
 #include <memory>
@@ -16,6 +17,8 @@
 #include <CuCMD/CuCMD.h>
 #include <Common.h>
 #include <CuCMD/CTimeSync.h>
+#include <deadline_queue_kes.h>
+#include <mpsc_ring_kes.h>
 
 namespace comm {
 
@@ -33,8 +36,12 @@ private:
     using CommHandler = std::shared_ptr<ICommunicator>;
     using TCommList = std::list<CommHandler>;
     using TCommMapper = std::map<std::string /*pvd-id*/, CommHandler /*communicator-instance*/>;
+    using TRouteMapper = std::unordered_map<std::string /*peer-app/peer-pvd@protocol*/, std::shared_ptr<const TCommList>>;
     using TListenMapper = std::map<std::string /*pvd-id*/, std::list<TListener> /*list of Listener-function*/>;
     using TPvdList = alias::IAliasSearcher::TPvdList;
+    using TReqHistory = time_pkg::CDeadlineQueue<std::string /*peer@msg-id*/, bool>;
+    using TListenJob = std::pair<std::string /*pvd-id*/, std::shared_ptr<CMDType>>;
+    using TListenQueue = lock_pkg::CMPSCring<TListenJob>;
 
 public:
     MCommunicator( const std::string& app_path, 
@@ -50,6 +57,7 @@ public:
 
     std::shared_ptr<alias::CAlias> get_myself(void);
 
+    /** Start providers & listener-thread. */
     void start( void );
 
     /** for client mode. */
@@ -61,13 +69,18 @@ public:
     /* return value: msg-id if sending req-msg is failed, then msg-id == 0, vice verse msg-id != 0  */
     uint32_t keepalive( const alias::CAlias& peer, const std::string& data, common::StateType state );
 
-    /* return value: msg-id if sending req-msg is failed, then msg-id == 0, vice verse msg-id != 0  */
-    uint32_t request( const alias::CAlias& peer, const std::string& json_cmd, common::StateType state, bool require_resp=true );
+    /* return value: msg-id if sending req-msg is failed, then msg-id == 0, vice verse msg-id != 0  
+     * msg_id      : msg-id to use for req-msg. (If msg_id == 0, then new msg-id is generated.) */
+    uint32_t request( const alias::CAlias& peer, const std::string& json_cmd, common::StateType state, 
+                      bool require_resp=true, uint32_t msg_id=0 );
 
     bool notify_action_start( const alias::CAlias& peer, unsigned long msg_id, E_STATE state );// for client mode.
 
     bool notify_action_done( const alias::CAlias& peer, unsigned long msg_id, E_STATE state ); // for client mode.
 
+    /** Action is stopped before its end. (Ex: pulse is cut by next CMD) Peer gets it as ACT-Fail instead of ACT-Done. */
+    bool notify_action_fail( const alias::CAlias& peer, unsigned long msg_id, E_STATE state ); // for client mode.
+
 private:
     MCommunicator(void) = delete;
     MCommunicator(const MCommunicator&) = delete;
@@ -80,7 +93,15 @@ private:
 
     void init_keepalive( std::string& pvd_id, std::list<std::string>& protocols, std::string target_protocol );
 
-    std::shared_ptr<TCommList> get_comms( const std::string& peer_app, const std::string& peer_pvd, std::string proto_name );
+    /** Communicators for peer & protocol. (It's cached in route-table until connection of any peer is changed.) */
+    std::shared_ptr<const TCommList> get_comms( const std::string& peer_app, const std::string& peer_pvd, const std::string& proto_name );
+
+    std::shared_ptr<const TCommList> search_comms( const std::string& peer_app, const std::string& peer_pvd, const std::string& proto_name );
+
+    void invalidate_routes( void );
+
+    /** Peer announced by KEEPALIVE that it accepts binary-body of CMD. */
+    bool is_binary_peer( const std::string& peer_app, const std::string& peer_pvd );
 
     void apply_sys_state(std::shared_ptr<::cmd::CuCMD>& cmd, common::StateType state=E_STATE::E_NO_STATE);
 
@@ -95,6 +116,21 @@ private:
 
     void call_listeners( std::string& pvd_id, std::shared_ptr<CMDType>& rcmd );
 
+    /** Hand over CMD to listener-thread. return false, if listener-queue is saturated. */
+    bool dispatch_listeners( std::string& pvd_id, std::shared_ptr<CMDType>& rcmd );
+
+    /** Listener-thread : listeners are called in order of receiving, so slow listener does not delay ACK. */
+    void run_listeners( void );
+
+    void stop_listeners( void );
+
+    bool is_duplicated_request( std::shared_ptr<CMDType>& rcmd );
+
+    /** Remove request from history, so re-sent request by peer is accepted again. */
+    void forget_request( std::shared_ptr<CMDType>& rcmd );
+
+    static std::string get_request_key( std::shared_ptr<CMDType>& rcmd );
+
     /*****
      * Call-Back handler.
      */
@@ -117,10 +153,26 @@ private:
 
     TCommMapper _mm_comm_;          // multi-communicator
 
+    TRouteMapper _mm_routes_;       // route-table : (peer, protocol) -> communicators.
+
+    std::mutex _mtx_routes_;
+
     TListenMapper _mm_listener_;    // multi-listener per provider-id.
 
+    TReqHistory _m_req_history_;    // received requests for filtering of re-sent request.
+
+    TListenQueue _m_listen_jobs_;   // received CMDs that are waiting for listeners.
+
+    std::thread _mt_listener_;
+
+    std::atomic<size_t> _m_listen_dropped_;     // CMDs that are not ACKed because listener-queue is saturated.
+
     static constexpr const double MAX_HOLD_TIME = 24 * 3600.0;     // 24 hour
 
+    static constexpr const size_t LISTEN_QUEUE_SIZE = 1024;
+
+    static constexpr const double REQ_HISTORY_HOLD_TIME = 600.0;    // 10 minute
+
 };
 
 
@@ -0,0 +1,233 @@
+#ifndef _MPSC_RING_BUFFER_BY_KES_H_
+#define _MPSC_RING_BUFFER_BY_KES_H_
+
+#include <atomic>
+#include <memory>
+#include <cerrno>
+#include <cstdint>
+#include <stdexcept>
+
+#include <unistd.h>
+#include <sys/eventfd.h>
+
+namespace lock_pkg {
+
+
+/***
+ * Bounded lock-free ring-buffer for Multi-Producer & Single-Consumer.
+ *  - push() is lock-free. (CAS on enqueue-position) It returns false, if ring is full.
+ *  - Consumer blocks on eventfd only when ring is empty,
+ *    so producer calls write() only when consumer is waiting.
+ *  - capacity is rounded up to power of 2.
+ ***/
+template <typename T>
+class CMPSCring {
+private:
+    class CCell {
+    public:
+        std::atomic<size_t> sequence;
+        T data;
+    };
+
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+
+public:
+    explicit CMPSCring( size_t capacity )
+    : _m_mask_(0), _m_fd_(-1), _m_is_waiting_(false), _m_is_stop_(false), 
+      _m_enqueue_pos_(0), _m_dequeue_pos_(0), _m_high_water_(0) {
+        size_t size = 2;
+        while( size < capacity ) {
+            size <<= 1;
+        }
+
+        _m_mask_ = size - 1;
+        _m_cells_.reset( new CCell[size] );
+        for( size_t i=0; i < size; i++ ) {
+            _m_cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+
+        _m_fd_ = eventfd(0, EFD_CLOEXEC);
+        if( _m_fd_ < 0 ) {
+            throw std::runtime_error("eventfd() is failed. (errno=" + std::to_string(errno) + ")");
+        }
+    }
+
+    ~CMPSCring( void ) {
+        stop();
+        if( _m_fd_ >= 0 ) {
+            close(_m_fd_);
+            _m_fd_ = -1;
+        }
+    }
+
+    /** Multi-Producer: return false, if ring is full or stopped. */
+    bool push( T value ) {
+        CCell* cell = NULL;
+        size_t pos = _m_enqueue_pos_.load(std::memory_order_relaxed);
+
+        if( _m_is_stop_.load(std::memory_order_relaxed) == true ) {
+            return false;
+        }
+
+        while( true ) {
+            cell = &_m_cells_[pos & _m_mask_];
+            size_t seq = cell->sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+
+            if( diff == 0 ) {
+                if( _m_enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed) == true ) {
+                    break;
+                }
+            }
+            else if( diff < 0 ) {
+                return false;   // full
+            }
+            else {
+                pos = _m_enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->data = std::move(value);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+
+        // consumer may already drain over this cell, then depth is not counted. (avoid wrap-around of unsigned)
+        size_t dequeue_pos = _m_dequeue_pos_.load(std::memory_order_relaxed);
+        if( pos + 1 > dequeue_pos ) {
+            update_high_water( pos + 1 - dequeue_pos );
+        }
+        wake_up();
+        return true;
+    }
+
+    /** Single-Consumer: Non-Blocking. */
+    bool try_pop( T& value ) {
+        size_t pos = _m_dequeue_pos_.load(std::memory_order_relaxed);
+        CCell* cell = &_m_cells_[pos & _m_mask_];
+        size_t seq = cell->sequence.load(std::memory_order_acquire);
+
+        if( static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1) < 0 ) {
+            return false;   // empty
+        }
+
+        value = std::move(cell->data);
+        cell->data = T();
+        cell->sequence.store(pos + _m_mask_ + 1, std::memory_order_release);
+        _m_dequeue_pos_.store(pos + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /** Single-Consumer: Blocking until value exist. return false, if stop() is called. */
+    bool wait_pop( T& value ) {
+        while( true ) {
+            if( try_pop(value) == true ) {
+                return true;
+            }
+
+            if( _m_is_stop_.load() == true ) {
+                return false;
+            }
+
+            // Announce sleeping, then check again. (push after the announcement will write eventfd.)
+            _m_is_waiting_.store(true);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if( try_pop(value) == true ) {
+                _m_is_waiting_.store(false);
+                return true;
+            }
+
+            if( _m_is_stop_.load() == true ) {
+                _m_is_waiting_.store(false);
+                return false;
+            }
+
+            uint64_t count = 0;
+            while( read(_m_fd_, &count, sizeof(count)) < 0 && errno == EINTR ) {
+                ;
+            }
+        }
+    }
+
+    /** Wake up consumer, and wait_pop() return false when ring is empty. */
+    void stop( void ) {
+        uint64_t count = 1;
+        _m_is_stop_.store(true);
+        if( _m_fd_ >= 0 && write(_m_fd_, &count, sizeof(count)) < 0 ) {
+            ;   // eventfd counter is overflowed. consumer is already waked up.
+        }
+    }
+
+    bool is_stopped( void ) const {
+        return _m_is_stop_.load();
+    }
+
+    size_t capacity( void ) const {
+        return _m_mask_ + 1;
+    }
+
+    size_t depth( void ) const {
+        size_t enqueue_pos = _m_enqueue_pos_.load(std::memory_order_relaxed);
+        size_t dequeue_pos = _m_dequeue_pos_.load(std::memory_order_relaxed);
+        return enqueue_pos >= dequeue_pos ? enqueue_pos - dequeue_pos : 0;
+    }
+
+    size_t high_water( void ) const {
+        return _m_high_water_.load(std::memory_order_relaxed);
+    }
+
+private:
+    CMPSCring(const CMPSCring&) = delete;             // copy constructor
+    CMPSCring& operator=(const CMPSCring&) = delete;  // copy operator
+    CMPSCring(CMPSCring&&) = delete;                  // move constructor
+    CMPSCring& operator=(CMPSCring&&) = delete;       // move operator
+
+    void update_high_water( size_t depth ) {
+        size_t prev = _m_high_water_.load(std::memory_order_relaxed);
+        while( depth > prev && _m_high_water_.compare_exchange_weak(prev, depth, std::memory_order_relaxed) == false ) {
+            ;
+        }
+    }
+
+    void wake_up( void ) {
+        uint64_t count = 1;
+
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if( _m_is_waiting_.load(std::memory_order_relaxed) == true && _m_is_waiting_.exchange(false) == true ) {
+            if( write(_m_fd_, &count, sizeof(count)) < 0 ) {
+                ;   // eventfd counter is overflowed. consumer is already waked up.
+            }
+        }
+    }
+
+private:
+    size_t _m_mask_;
+
+    std::unique_ptr<CCell[]> _m_cells_;
+
+    int _m_fd_;                                 // eventfd for waking up consumer.
+
+    std::atomic<bool> _m_is_waiting_;           // consumer is sleeping on eventfd.
+
+    std::atomic<bool> _m_is_stop_;
+
+    char _m_pad0_[CACHE_LINE_SIZE];             // padding for false-sharing between producers & consumer.
+
+    std::atomic<size_t> _m_enqueue_pos_;
+
+    char _m_pad1_[CACHE_LINE_SIZE];
+
+    std::atomic<size_t> _m_dequeue_pos_;
+
+    char _m_pad2_[CACHE_LINE_SIZE];
+
+    std::atomic<size_t> _m_high_water_;
+
+};
+
+
+template <typename T>
+constexpr size_t CMPSCring<T>::CACHE_LINE_SIZE;
+
+
+}   // namespace lock_pkg
+
+#endif // _MPSC_RING_BUFFER_BY_KES_H_
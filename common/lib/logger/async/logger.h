@@ -0,0 +1,49 @@
+#ifndef _H_LOCAL_PRINT_AS_ASYNC_
+#define _H_LOCAL_PRINT_AS_ASYNC_
+
+#include <stdio.h>
+#include <async_logger_kes.h>
+
+
+// Raw-Logic definition of Logger.
+#define _HEXOUT(buf, length, fmt, ...)   \
+            {               \
+                int _i_ = 0;      \
+                printf("["LOGGER_TAG"]HEX: " "%s(%s:%d):length=%u, HEXOUTPUT:\n" fmt, _FUNC_NAME_, _FILE_NAME_, __LINE__, length, ##__VA_ARGS__);   \
+                for(_i_=0; _i_ < (length); _i_++)       \
+                {           \
+                    printf(" %02X", (buf)[_i_]);   \
+                }           \
+                printf( "\n");   \
+            }
+// printf() is never called. It's only for format-checking of compiler. (-Wformat)
+#define _ASYNC_WRITE(level, fmt, ...)   \
+    {   \
+        if( 0 ) { printf(fmt, ##__VA_ARGS__); }   \
+        ::logger_pkg::CAsyncLogger::write(level, fmt, ##__VA_ARGS__);    \
+    }
+#define _DBG(fmt, ...)   \
+    _ASYNC_WRITE(LOG_LEVEL_DEBUG, fmt, ##__VA_ARGS__)
+#define _INFO(fmt, ...)  \
+    _ASYNC_WRITE(LOG_LEVEL_INFO, fmt, ##__VA_ARGS__)
+#define _WARN(fmt, ...)  \
+    _ASYNC_WRITE(LOG_LEVEL_WARN, fmt, ##__VA_ARGS__)
+#define _ERR(fmt, ...)   \
+    {   \
+        _ASYNC_WRITE(LOG_LEVEL_ERR, fmt, ##__VA_ARGS__);    \
+        LOG_EXIT(-1);   \
+    }
+
+
+
+// API of Logger. (time-stamp & color are applied by sink of writer-thread.)
+#define _PRINT_HEX_(buf, length, fmt, ...)       _HEXOUT(buf, length, fmt, ##__VA_ARGS__)
+#define _PRINT_D_(fmt, ...)              _DBG("["LOGGER_TAG"]D: " "%s(%s:%d):" fmt, _FUNC_NAME_, _FILE_NAME_, __LINE__, ##__VA_ARGS__)
+#define _PRINT_W_(fmt, ...)              _WARN("["LOGGER_TAG"]W: " "%s(%s:%d):" fmt, _FUNC_NAME_, _FILE_NAME_, __LINE__, ##__VA_ARGS__)
+#define _PRINT_ERR_(fmt, ...)            _ERR("["LOGGER_TAG"]E: " "%s(%s:%d):" fmt, _FUNC_NAME_, _FILE_NAME_, __LINE__, ##__VA_ARGS__)
+#define _PRINT_I_(fmt, ...)              _INFO("["LOGGER_TAG"]I: " "%s(%s:%d):" fmt, _FUNC_NAME_, _FILE_NAME_, __LINE__, ##__VA_ARGS__)
+
+
+
+
+#endif // _H_LOCAL_PRINT_AS_ASYNC_
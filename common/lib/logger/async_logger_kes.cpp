@@ -0,0 +1,595 @@
+#include <ctime>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <algorithm>
+
+#include <log_level.h>
+#include <async_logger_kes.h>
+#include <binary_log_kes.h>
+
+#ifndef LOG_MODE_STDOUT
+    #include <CdltLogger.h>
+
+    #ifndef LOG_DLT_APPID
+        #define LOG_DLT_APPID NULL
+    #endif // LOG_DLT_APPID
+
+    #ifndef LOG_DLT_CID
+        #define LOG_DLT_CID   "none"
+    #endif // LOG_DLT_CID
+#endif // LOG_MODE_STDOUT
+
+#ifndef LOGGER_TAG
+    #define LOGGER_TAG              "NONE"
+#endif
+
+namespace logger_pkg {
+
+constexpr const char* CAsyncLogger::ENV_RING_SIZE;
+constexpr size_t CAsyncLogger::DEFAULT_RING_SIZE;
+constexpr size_t CAsyncLogger::MAX_RING_SIZE;
+constexpr size_t CAsyncLogger::ARGS_SIZE;
+constexpr uint32_t CAsyncLogger::FLUSH_INTERVAL_MS;
+
+namespace {
+
+constexpr size_t NUMBER_ARG_SIZE = 1 + sizeof(uint64_t);        // type, value
+constexpr size_t STRING_ARG_HEADER_SIZE = 1 + sizeof(uint16_t); // type, length
+constexpr size_t SPEC_SIZE = 32;
+constexpr size_t TIME_STR_SIZE = 24;
+constexpr size_t CACHE_LINE_SIZE = 64;
+
+const char* const COLOR_RED = "\033[0;31m";
+const char* const COLOR_BROWN = "\033[0;33m";
+const char* const COLOR_BLUE = "\033[0;34m";
+const char* const COLOR_END = "\033[0;m";
+
+/** It's false before logger is created or after it's destroyed. (Ex: logging in static destructor) */
+std::atomic<bool> g_is_available(false);
+
+/** Size of ring from env. (It's rounded up to power of 2.) */
+size_t get_ring_size(void) {
+    const char* value = getenv( CAsyncLogger::ENV_RING_SIZE );
+    size_t count = 0;
+    size_t size = 1;
+
+    if( value == NULL || (count = strtoul(value, NULL, 10)) == 0 ) {
+        return CAsyncLogger::DEFAULT_RING_SIZE;
+    }
+
+    count = std::min( count, CAsyncLogger::MAX_RING_SIZE );
+    while( size < count ) {
+        size <<= 1;
+    }
+    return size;
+}
+
+/** Narrow 64-bit argument to width of length-modifier. (It's same with printf that reads int, if modifier is not exist.) */
+uint64_t narrow( uint64_t number, const std::string& length, bool is_signed ) {
+    if( length.empty() == true ) {
+        return is_signed ? static_cast<uint64_t>(static_cast<int64_t>(static_cast<int32_t>(number)))
+                         : static_cast<uint64_t>(static_cast<uint32_t>(number));
+    }
+    else if( length == "h" ) {
+        return is_signed ? static_cast<uint64_t>(static_cast<int64_t>(static_cast<int16_t>(number)))
+                         : static_cast<uint64_t>(static_cast<uint16_t>(number));
+    }
+    else if( length == "hh" ) {
+        return is_signed ? static_cast<uint64_t>(static_cast<int64_t>(static_cast<int8_t>(number)))
+                         : static_cast<uint64_t>(static_cast<uint8_t>(number));
+    }
+    else if( length == "l" || length == "z" || length == "t" ) {
+        return is_signed ? static_cast<uint64_t>(static_cast<int64_t>(static_cast<long>(number)))
+                         : static_cast<uint64_t>(static_cast<unsigned long>(number));
+    }
+    return number;      // ll, j, q : 64-bit
+}
+
+/** Reader of serialized arguments. */
+class CArgReader {
+public:
+    explicit CArgReader( const CAsyncLogger::CRecord& record ) : _m_record_(record), _m_pos_(0) {}
+
+    bool next( uint8_t& type, uint64_t& number, const char*& str, uint16_t& str_len ) {
+        if( _m_pos_ >= _m_record_.length ) {
+            return false;
+        }
+
+        type = static_cast<uint8_t>(_m_record_.args[_m_pos_]);
+        if( type == CAsyncLogger::E_ARG_STR ) {
+            memcpy( &str_len, _m_record_.args + _m_pos_ + 1, sizeof(str_len) );
+            str = _m_record_.args + _m_pos_ + STRING_ARG_HEADER_SIZE;
+            _m_pos_ += STRING_ARG_HEADER_SIZE + str_len;
+        }
+        else {
+            memcpy( &number, _m_record_.args + _m_pos_ + 1, sizeof(number) );
+            _m_pos_ += NUMBER_ARG_SIZE;
+        }
+        return true;
+    }
+
+private:
+    const CAsyncLogger::CRecord& _m_record_;
+
+    size_t _m_pos_;
+
+};
+
+}   // namespace
+
+
+/*********************************
+ * Ring-buffer of a thread. (Single-Producer : owner-thread, Single-Consumer : writer-thread)
+ */
+class CAsyncLogger::CRing {
+public:
+    explicit CRing( size_t size ) : head(0), tail(0), dropped(0), is_closed(false), mask(size - 1), records(size) {}
+
+    std::atomic<size_t> head;           // next position to write. (producer)
+
+    char pad0[CACHE_LINE_SIZE];         // padding for false-sharing between producer & consumer.
+
+    std::atomic<size_t> tail;           // next position to read. (consumer)
+
+    char pad1[CACHE_LINE_SIZE];
+
+    std::atomic<uint64_t> dropped;
+
+    std::atomic<bool> is_closed;        // owner-thread is terminated.
+
+    const size_t mask;                  // size - 1
+
+    std::vector<CRecord> records;
+
+};
+
+/** Owner of ring in thread-local storage. Ring is closed at thread exit, then writer releases it after draining. */
+class CAsyncLogger::CRingHolder {
+public:
+    CRingHolder(void) : ring( std::make_shared<CRing>(get_instance()._m_ring_size_) ) {
+        CAsyncLogger& logger = get_instance();
+        std::lock_guard<std::mutex> guard(logger._mtx_rings_);
+        logger._mv_rings_.push_back( ring );
+    }
+
+    ~CRingHolder(void) {
+        ring->is_closed.store(true);
+    }
+
+    std::shared_ptr<CRing> ring;
+
+};
+
+
+/*********************************
+ * Definition of Public Function.
+ */
+CAsyncLogger::~CAsyncLogger(void) {
+    {
+        std::lock_guard<std::mutex> guard(_mtx_writer_);
+        _m_is_continue_ = false;
+    }
+    _m_cv_.notify_all();
+
+    if( _mt_writer_.joinable() == true ) {
+        _mt_writer_.join();     // writer drains remained records before exit.
+    }
+    g_is_available.store(false);
+    _m_binary_.reset();
+}
+
+uint64_t CAsyncLogger::get_dropped(void) {
+    uint64_t dropped = 0;
+
+    if( is_available() == false ) {
+        return dropped;
+    }
+
+    CAsyncLogger& logger = get_instance();
+    std::lock_guard<std::mutex> guard(logger._mtx_rings_);
+    for( auto itr=logger._mv_rings_.begin(); itr!=logger._mv_rings_.end(); itr++ ) {
+        dropped += (*itr)->dropped.load(std::memory_order_relaxed);
+    }
+    return dropped + logger._m_reported_.load();
+}
+
+
+/*********************************
+ * Definition of Private Function.
+ */
+CAsyncLogger::CAsyncLogger(void)
+: _m_is_continue_(true), _m_is_urgent_(false), _m_ring_size_(get_ring_size()), _m_reported_(0) {
+    open_binary();
+    _mt_writer_ = std::thread(&CAsyncLogger::run, this);
+    g_is_available.store(true);
+}
+
+CAsyncLogger& CAsyncLogger::get_instance(void) {
+    static CAsyncLogger instance;
+    return instance;
+}
+
+bool CAsyncLogger::is_available(void) {
+    static std::once_flag created;
+
+    std::call_once( created, [](void) { get_instance(); } );
+    return g_is_available.load(std::memory_order_relaxed);
+}
+
+uint64_t CAsyncLogger::now_ns(void) {
+    struct timespec tspec;
+    clock_gettime( CLOCK_MONOTONIC, &tspec );
+    return static_cast<uint64_t>(tspec.tv_sec) * 1000000000ULL + static_cast<uint64_t>(tspec.tv_nsec);
+}
+
+CAsyncLogger::CRing* CAsyncLogger::get_ring(void) {
+    static thread_local CRingHolder holder;
+    return holder.ring.get();
+}
+
+CAsyncLogger::CRecord* CAsyncLogger::reserve( CRing* ring ) {
+    size_t head = ring->head.load(std::memory_order_relaxed);
+
+    if( head - ring->tail.load(std::memory_order_acquire) > ring->mask ) {
+        ring->dropped.fetch_add(1, std::memory_order_relaxed);
+        return NULL;
+    }
+    return &ring->records[head & ring->mask];
+}
+
+void CAsyncLogger::commit( CRing* ring, uint32_t level ) {
+    size_t head = ring->head.load(std::memory_order_relaxed) + 1;
+    ring->head.store( head, std::memory_order_release );
+
+    // Count of records increases one by one, so writer is woken up once when ring becomes half full.
+    bool is_half = ( head - ring->tail.load(std::memory_order_relaxed) == (ring->mask + 1) / 2 );
+
+    if( level == LOG_LEVEL_ERR || is_half == true ) {
+        CAsyncLogger& logger = get_instance();
+        {
+            std::lock_guard<std::mutex> guard(logger._mtx_writer_);
+            logger._m_is_urgent_ = true;
+        }
+        logger._m_cv_.notify_one();
+    }
+}
+
+void CAsyncLogger::write_sync( const CRecord& record ) {
+    std::string line;
+
+    format( record, line );
+    sink( record, line );
+#ifdef LOG_MODE_STDOUT
+    fflush( stdout );
+#endif
+}
+
+void CAsyncLogger::put_pointer( CRecord& record, const char* value ) {
+    size_t remain = 0;
+    uint16_t length = 0;
+
+    if( value == NULL ) {
+        value = "(null)";
+    }
+
+    if( record.length + STRING_ARG_HEADER_SIZE > ARGS_SIZE ) {
+        record.truncated = true;
+        return;
+    }
+
+    remain = ARGS_SIZE - record.length - STRING_ARG_HEADER_SIZE;
+    length = static_cast<uint16_t>( strnlen(value, remain) );
+    if( value[length] != '\0' ) {
+        record.truncated = true;
+    }
+
+    record.args[record.length] = static_cast<char>(E_ARG_STR);
+    memcpy( record.args + record.length + 1, &length, sizeof(length) );
+    memcpy( record.args + record.length + STRING_ARG_HEADER_SIZE, value, length );
+    record.length += STRING_ARG_HEADER_SIZE + length;
+}
+
+void CAsyncLogger::put_pointer( CRecord& record, const void* value ) {
+    put_number( record, E_ARG_PTR, static_cast<uint64_t>(reinterpret_cast<uintptr_t>(value)) );
+}
+
+void CAsyncLogger::put_number( CRecord& record, E_ARG type, uint64_t value ) {
+    if( record.length + NUMBER_ARG_SIZE > ARGS_SIZE ) {
+        record.truncated = true;
+        return;
+    }
+
+    record.args[record.length] = static_cast<char>(type);
+    memcpy( record.args + record.length + 1, &value, sizeof(value) );
+    record.length += NUMBER_ARG_SIZE;
+}
+
+/****
+ * Writer-thread
+ */
+void CAsyncLogger::run(void) {
+    std::vector<CRecord> records;
+    std::string line;
+    bool is_continue = true;
+
+    while( is_continue == true ) {
+        {
+            std::unique_lock<std::mutex> lk(_mtx_writer_);
+            _m_cv_.wait_for( lk, std::chrono::milliseconds(FLUSH_INTERVAL_MS), [this](void) {
+                return _m_is_urgent_ == true || _m_is_continue_ == false;
+            } );
+            _m_is_urgent_ = false;
+            is_continue = _m_is_continue_;
+        }
+
+        drain( records );
+        if( records.empty() == true ) {
+            continue;
+        }
+
+        // Records of threads are merged in order of time.
+        std::stable_sort( records.begin(), records.end(), [](const CRecord& a, const CRecord& b) {
+            return a.time_ns < b.time_ns;
+        } );
+
+        for( auto itr=records.begin(); itr!=records.end(); itr++ ) {
+            emit( *itr, line );
+        }
+        records.clear();
+#ifdef LOG_MODE_STDOUT
+        fflush( stdout );
+#endif
+    }
+}
+
+void CAsyncLogger::drain( std::vector<CRecord>& records ) {
+    uint64_t dropped = 0;
+    std::lock_guard<std::mutex> guard(_mtx_rings_);
+
+    for( auto itr=_mv_rings_.begin(); itr!=_mv_rings_.end(); ) {
+        CRing& ring = **itr;
+        bool is_closed = ring.is_closed.load(std::memory_order_acquire);
+        size_t tail = ring.tail.load(std::memory_order_relaxed);
+        size_t head = ring.head.load(std::memory_order_acquire);
+
+        for( ; tail != head; tail++ ) {
+            records.push_back( ring.records[tail & ring.mask] );
+        }
+        ring.tail.store(tail, std::memory_order_release);
+        dropped += ring.dropped.exchange(0, std::memory_order_relaxed);
+
+        if( is_closed == true ) {
+            itr = _mv_rings_.erase(itr);    // owner-thread is terminated & its records are drained.
+        }
+        else {
+            itr++;
+        }
+    }
+
+    if( dropped > 0 ) {
+        report_dropped( dropped );
+    }
+}
+
+void CAsyncLogger::report_dropped( uint64_t dropped ) {
+    static const char* const FMT_DROPPED = "[" LOGGER_TAG "]W: %s:%llu log-messages are dropped. (total=%llu)";
+    CRecord record;
+
+    uint64_t total = _m_reported_.fetch_add(dropped) + dropped;
+    record.fmt = FMT_DROPPED;
+    record.level = LOG_LEVEL_WARN;
+    record.time_ns = now_ns();
+    record.length = 0;
+    record.truncated = false;
+    pack( record, "CAsyncLogger", dropped, total );
+
+    std::string line;
+    emit( record, line );
+}
+
+void CAsyncLogger::open_binary(void) {
+    const char* path = getenv( CBinaryLog::ENV_FILE );
+    const char* slots = getenv( CBinaryLog::ENV_SLOTS );
+    uint32_t slot_count = CBinaryLog::DEFAULT_SLOT_COUNT;
+
+    if( path == NULL || path[0] == '\0' ) {
+        return;
+    }
+
+    if( slots != NULL && strtoul(slots, NULL, 10) > 0 ) {
+        slot_count = static_cast<uint32_t>( strtoul(slots, NULL, 10) );
+    }
+
+    _m_binary_.reset( new CBinaryLog() );
+    if( _m_binary_->open(path, slot_count) == false ) {
+        fprintf( stderr, "[" LOGGER_TAG "]W: CAsyncLogger: can not open binary log-file(%s). Text-log is used.\n", path );
+        _m_binary_.reset();
+    }
+}
+
+void CAsyncLogger::emit( const CRecord& record, std::string& line ) {
+    if( _m_binary_ != NULL ) {
+        _m_binary_->write( record );
+        if( record.level == LOG_LEVEL_ERR ) {
+            _m_binary_->sync();     // history before error is written-back early.
+        }
+        if( record.level > LOG_LEVEL_WARN ) {
+            return;     // DEBUG/INFO are kept in only binary log-file.
+        }
+    }
+
+    format( record, line );
+    sink( record, line );
+}
+
+/** printf-style formatting with serialized arguments. (length-modifier of format is replaced by type of argument.) */
+void CAsyncLogger::format( const CRecord& record, std::string& line ) {
+    CArgReader reader( record );
+    const char* pos = record.fmt;
+    char buf[ARGS_SIZE + SPEC_SIZE];
+
+    line.clear();
+    while( *pos != '\0' ) {
+        const char* start = strchr( pos, '%' );
+        if( start == NULL ) {
+            line.append( pos );
+            break;
+        }
+        line.append( pos, start - pos );
+
+        if( start[1] == '%' ) {
+            line.push_back( '%' );
+            pos = start + 2;
+            continue;
+        }
+
+        // parse conversion-spec : %[flags][width][.precision][length]conversion
+        std::string spec = "%";
+        const char* cur = start + 1;
+        while( *cur != '\0' && strchr("-+ #0", *cur) != NULL ) {
+            spec.push_back( *cur++ );
+        }
+        while( *cur != '\0' && (isdigit(*cur) || *cur == '.' || *cur == '*') ) {
+            if( *cur == '*' ) {
+                uint8_t type = 0;
+                uint64_t number = 0;
+                const char* str = NULL;
+                uint16_t str_len = 0;
+                spec += reader.next(type, number, str, str_len) ? std::to_string(static_cast<int>(number)) : "0";
+                cur++;
+            }
+            else {
+                spec.push_back( *cur++ );
+            }
+        }
+        // length-modifier is re-decided by type of argument, but value is narrowed like printf. (Ex: %u with -1 == 4294967295)
+        std::string length;
+        while( *cur != '\0' && strchr("hlLqjzt", *cur) != NULL ) {
+            length.push_back( *cur++ );
+        }
+
+        char conv = *cur;
+        if( conv == '\0' ) {
+            break;
+        }
+        pos = cur + 1;
+
+        uint8_t type = 0;
+        uint64_t number = 0;
+        const char* str = NULL;
+        uint16_t str_len = 0;
+        if( reader.next(type, number, str, str_len) == false ) {
+            line.append( "(no-arg)" );
+            continue;
+        }
+
+        int written = -1;
+        switch( conv ) {
+        case 'd': case 'i':
+        case 'u': case 'o': case 'x': case 'X': case 'c':
+            if( type == E_ARG_DOUBLE || type == E_ARG_STR ) {
+                break;
+            }
+            number = narrow( number, length, (conv == 'd' || conv == 'i') );
+            if( conv == 'c' ) {
+                written = snprintf( buf, sizeof(buf), (spec + "c").c_str(), static_cast<int>(number) );
+            }
+            else if( conv == 'd' || conv == 'i' ) {
+                written = snprintf( buf, sizeof(buf), (spec + "lld").c_str(), static_cast<long long>(number) );
+            }
+            else {
+                spec += "ll";
+                spec.push_back( conv );
+                written = snprintf( buf, sizeof(buf), spec.c_str(), static_cast<unsigned long long>(number) );
+            }
+            break;
+        case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+            {
+                double value = 0.0;
+                if( type == E_ARG_DOUBLE ) {
+                    memcpy( &value, &number, sizeof(value) );
+                }
+                else if( type == E_ARG_INT ) {
+                    value = static_cast<double>(static_cast<int64_t>(number));
+                }
+                else if( type == E_ARG_UINT ) {
+                    value = static_cast<double>(number);
+                }
+                else {
+                    break;
+                }
+                spec.push_back( conv );
+                written = snprintf( buf, sizeof(buf), spec.c_str(), value );
+            }
+            break;
+        case 's':
+            if( type == E_ARG_STR ) {
+                std::string value( str, str_len );
+                written = snprintf( buf, sizeof(buf), (spec + "s").c_str(), value.c_str() );
+            }
+            break;
+        case 'p':
+            written = snprintf( buf, sizeof(buf), "%p", reinterpret_cast<void*>(static_cast<uintptr_t>(number)) );
+            break;
+        default:
+            break;
+        }
+
+        if( written < 0 ) {
+            line.append( "(bad-arg)" );
+        }
+        else {
+            line.append( buf, std::min(static_cast<size_t>(written), sizeof(buf) - 1) );
+        }
+    }
+
+    if( record.truncated == true ) {
+        line.append( " (truncated)" );
+    }
+}
+
+void CAsyncLogger::sink( const CRecord& record, std::string& line ) {
+#ifdef LOG_MODE_STDOUT
+    const char* color = NULL;
+    char time_str[TIME_STR_SIZE] = "";
+
+    switch( record.level ) {
+    case LOG_LEVEL_DEBUG:   color = COLOR_BLUE;     break;
+    case LOG_LEVEL_WARN:    color = COLOR_BROWN;    break;
+    case LOG_LEVEL_ERR:     color = COLOR_RED;      break;
+    default:                                        break;
+    }
+
+#ifdef LOG_TIME_ENABLE
+    {   // monotonic time of record -> real-time for human-readable.
+        static thread_local time_t cached_sec = 0;
+        static thread_local char cached_str[TIME_STR_SIZE] = "";
+        struct timespec real_now;
+        tm cur_tm;
+
+        clock_gettime( CLOCK_REALTIME, &real_now );
+        time_t sec = real_now.tv_sec - static_cast<time_t>( (now_ns() - record.time_ns) / 1000000000ULL );
+        if( sec != cached_sec ) {
+            localtime_r( &sec, &cur_tm );
+            strftime( cached_str, sizeof(cached_str), "[%Y-%m-%d][%T]", &cur_tm );
+            cached_sec = sec;
+        }
+        memcpy( time_str, cached_str, sizeof(time_str) );
+    }
+#endif
+
+    if( color != NULL ) {
+        fprintf( stdout, "%s%s%s%s\n", time_str, color, line.c_str(), COLOR_END );
+    }
+    else {
+        fprintf( stdout, "%s%s\n", time_str, line.c_str() );
+    }
+#else
+    line.push_back( '\n' );
+    ::dlt::CdltLogger::get_instance(LOG_DLT_APPID, LOG_DLT_CID).print( NULL, 0, record.level, "%s", line.c_str() );
+#endif
+}
+
+
+}   // namespace logger_pkg
@@ -0,0 +1,219 @@
+#ifndef _ASYNC_LOGGER_BY_KES_H_
+#define _ASYNC_LOGGER_BY_KES_H_
+
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <memory>
+#include <string>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <condition_variable>
+
+namespace logger_pkg {
+
+class CBinaryLog;
+
+/***
+ * Asynchronous logger. (backend of LOGD/LOGI/LOGW/LOGERR, if LOG_ASYNC_ENABLE is defined.)
+ *  - Caller only records format-pointer + raw arguments + monotonic timestamp
+ *    into ring-buffer of its thread. (lock-free Single-Producer & Single-Consumer)
+ *  - Writer-thread drains all of rings, formats records in order of timestamp,
+ *    and writes them to sink. (stdout or DLT)
+ *  - If ring is half full (or ERR-level record is pushed), writer is woken up before FLUSH_INTERVAL_MS.
+ *  - If ring is full, record is dropped and counted. Writer reports dropped count to sink.
+ *    (Size of ring can be changed by LOG_ASYNC_RING_SIZE env for a burst of logs.)
+ *  - Format must be string-literal, because only its pointer is kept.
+ *    String arguments are copied into record. (It's truncated, if record is full.)
+ *  - If LOG_BINARY_FILE env is set, records are captured into binary log-file without formatting,
+ *    and only WARN/ERR records are written to sink. (refer to CBinaryLog)
+ ***/
+class CAsyncLogger {
+public:
+    static constexpr const char* ENV_RING_SIZE = "LOG_ASYNC_RING_SIZE";
+    static constexpr size_t DEFAULT_RING_SIZE = 256;    // records per thread. (power of 2)
+    static constexpr size_t MAX_RING_SIZE = 65536;
+    static constexpr size_t ARGS_SIZE = 224;            // bytes of arguments per record.
+    static constexpr uint32_t FLUSH_INTERVAL_MS = 20;   // max waiting time of record in ring.
+
+    class CRecord {
+    public:
+        const char* fmt;
+
+        uint64_t time_ns;       // CLOCK_MONOTONIC
+
+        uint32_t level;
+
+        uint16_t length;        // used bytes of args.
+
+        bool truncated;
+
+        char args[ARGS_SIZE];   // { [type:1][value:8] | [type:1][length:2][string:length] }...
+    };
+
+    /** Type of serialized argument. */
+    enum E_ARG : uint8_t {
+        E_ARG_INT = 1,
+        E_ARG_UINT,
+        E_ARG_DOUBLE,
+        E_ARG_STR,
+        E_ARG_PTR
+    };
+
+private:
+    class CRing;
+
+    class CRingHolder;
+
+public:
+    ~CAsyncLogger(void);
+
+    /** Record log-message. (Non-Blocking: It's formatted by writer-thread.) */
+    template <typename... Targs>
+    static void write( uint32_t level, const char* fmt, Targs... args ) {
+        CRecord stack_record;
+        CRecord* record = NULL;
+        CRing* ring = NULL;
+
+        if( is_available() == true ) {
+            ring = get_ring();
+            record = reserve( ring );
+            if( record == NULL ) {
+                return;     // ring is full. (counted as dropped)
+            }
+        }
+        else {
+            record = &stack_record;     // writer is not running. (Ex: at termination) so it's written directly.
+        }
+
+        record->fmt = fmt;
+        record->level = level;
+        record->time_ns = now_ns();
+        record->length = 0;
+        record->truncated = false;
+        pack( *record, args... );
+
+        if( ring != NULL ) {
+            commit( ring, level );
+        }
+        else {
+            write_sync( *record );
+        }
+    }
+
+    /** Total count of dropped records. */
+    static uint64_t get_dropped(void);
+
+    /** printf-style formatting with serialized arguments. (Ex: for decoder of binary log-file) */
+    static void format( const CRecord& record, std::string& line );
+
+private:
+    CAsyncLogger(void);
+
+    CAsyncLogger(const CAsyncLogger&) = delete;             // copy constructor
+    CAsyncLogger& operator=(const CAsyncLogger&) = delete;  // copy operator
+    CAsyncLogger(CAsyncLogger&&) = delete;                  // move constructor
+    CAsyncLogger& operator=(CAsyncLogger&&) = delete;       // move operator
+
+    static CAsyncLogger& get_instance(void);
+
+    static bool is_available(void);
+
+    static uint64_t now_ns(void);
+
+    /** Ring of current thread. (It's registered to writer at first use in the thread.) */
+    static CRing* get_ring(void);
+
+    static CRecord* reserve( CRing* ring );
+
+    static void commit( CRing* ring, uint32_t level );
+
+    static void write_sync( const CRecord& record );
+
+    /** Serialize arguments. */
+    static void pack( CRecord& /*record*/ ) {}
+
+    template <typename T, typename... Trest>
+    static void pack( CRecord& record, T value, Trest... rest ) {
+        put( record, value );
+        pack( record, rest... );
+    }
+
+    template <typename T>
+    static typename std::enable_if<std::is_integral<T>::value>::type put( CRecord& record, T value ) {
+        if( std::is_signed<T>::value == true ) {
+            put_number( record, E_ARG_INT, static_cast<uint64_t>(static_cast<int64_t>(value)) );
+        }
+        else {
+            put_number( record, E_ARG_UINT, static_cast<uint64_t>(value) );
+        }
+    }
+
+    template <typename T>
+    static typename std::enable_if<std::is_enum<T>::value>::type put( CRecord& record, T value ) {
+        put( record, static_cast<typename std::underlying_type<T>::type>(value) );
+    }
+
+    template <typename T>
+    static typename std::enable_if<std::is_floating_point<T>::value>::type put( CRecord& record, T value ) {
+        double number = static_cast<double>(value);
+        uint64_t bits = 0;
+
+        memcpy( &bits, &number, sizeof(bits) );
+        put_number( record, E_ARG_DOUBLE, bits );
+    }
+
+    template <typename T>
+    static typename std::enable_if<std::is_pointer<T>::value>::type put( CRecord& record, T value ) {
+        put_pointer( record, value );
+    }
+
+    static void put_pointer( CRecord& record, const char* value );
+
+    static void put_pointer( CRecord& record, const void* value );
+
+    static void put_number( CRecord& record, E_ARG type, uint64_t value );
+
+    /** Writer-thread */
+    void run(void);
+
+    void drain( std::vector<CRecord>& records );
+
+    void report_dropped( uint64_t dropped );
+
+    void open_binary(void);
+
+    /** Write record to binary log-file and/or sink. */
+    void emit( const CRecord& record, std::string& line );
+
+    static void sink( const CRecord& record, std::string& line );
+
+private:
+    std::vector<std::shared_ptr<CRing>> _mv_rings_;
+
+    std::mutex _mtx_rings_;
+
+    std::thread _mt_writer_;
+
+    std::mutex _mtx_writer_;
+
+    std::condition_variable _m_cv_;
+
+    bool _m_is_continue_;
+
+    bool _m_is_urgent_;         // ERR-level record is pushed or ring is half full, so writer drains it without waiting.
+
+    size_t _m_ring_size_;       // records per thread. (power of 2)
+
+    std::atomic<uint64_t> _m_reported_;     // dropped count that is already reported.
+
+    std::unique_ptr<CBinaryLog> _m_binary_;     // NULL, if binary log-file is not used.
+
+};
+
+
+}   // namespace logger_pkg
+
+#endif // _ASYNC_LOGGER_BY_KES_H_
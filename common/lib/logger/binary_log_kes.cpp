@@ -0,0 +1,243 @@
+#include <ctime>
+#include <cstdio>
+#include <atomic>
+#include <fstream>
+#include <algorithm>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#include <binary_log_kes.h>
+
+#ifndef LOGGER_TAG
+    #define LOGGER_TAG              "NONE"
+#endif
+
+namespace logger_pkg {
+
+constexpr const char* CBinaryLog::MAGIC;
+constexpr uint32_t CBinaryLog::VERSION;
+constexpr size_t CBinaryLog::HEADER_SIZE;
+constexpr size_t CBinaryLog::FORMAT_SIZE;
+constexpr uint32_t CBinaryLog::FORMAT_COUNT;
+constexpr uint32_t CBinaryLog::SITE_NONE;
+constexpr uint32_t CBinaryLog::DEFAULT_SLOT_COUNT;
+constexpr const char* CBinaryLog::ENV_FILE;
+constexpr const char* CBinaryLog::ENV_SLOTS;
+constexpr const char* CBinaryLog::OLD_SUFFIX;
+
+namespace {
+
+const char* const FMT_UNKNOWN_SITE = "(unknown call-site)";
+
+uint64_t get_clock_ns( clockid_t clock_id ) {
+    struct timespec tspec;
+    clock_gettime( clock_id, &tspec );
+    return static_cast<uint64_t>(tspec.tv_sec) * 1000000000ULL + static_cast<uint64_t>(tspec.tv_nsec);
+}
+
+}   // namespace
+
+
+/*********************************
+ * Definition of Public Function.
+ */
+CBinaryLog::CBinaryLog(void)
+: _m_fd_(-1), _m_map_(NULL), _m_map_size_(0), _m_header_(NULL), _m_formats_(NULL), _m_slots_(NULL), _m_seq_(0) {
+    static_assert( sizeof(CHeader) <= HEADER_SIZE, "CHeader is bigger than HEADER_SIZE." );
+}
+
+CBinaryLog::~CBinaryLog(void) {
+    close();
+}
+
+bool CBinaryLog::open( const std::string& path, uint32_t slot_count ) {
+    size_t size = get_file_size( slot_count );
+
+    if( is_opened() == true || path.empty() == true || slot_count == 0 ) {
+        return false;
+    }
+
+    rename( path.c_str(), (path + OLD_SUFFIX).c_str() );     // keep history of previous run. (Ex: before crash)
+
+    _m_fd_ = ::open( path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644 );
+    if( _m_fd_ < 0 ) {
+        return false;
+    }
+
+    if( ftruncate(_m_fd_, static_cast<off_t>(size)) != 0 ) {
+        close();
+        return false;
+    }
+
+    void* map = mmap( NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, _m_fd_, 0 );
+    if( map == MAP_FAILED ) {
+        close();
+        return false;
+    }
+
+    _m_map_ = static_cast<char*>(map);
+    _m_map_size_ = size;
+    _m_header_ = reinterpret_cast<CHeader*>(_m_map_);
+    _m_formats_ = _m_map_ + HEADER_SIZE;
+    _m_slots_ = reinterpret_cast<CSlot*>(_m_formats_ + FORMAT_SIZE * FORMAT_COUNT);
+    _m_seq_ = 0;
+    _mm_sites_.clear();
+
+    // file is zero-filled by ftruncate, so all of slots are empty.
+    _m_header_->version = VERSION;
+    _m_header_->slot_size = sizeof(CSlot);
+    _m_header_->args_size = CAsyncLogger::ARGS_SIZE;
+    _m_header_->format_size = FORMAT_SIZE;
+    _m_header_->format_count = FORMAT_COUNT;
+    _m_header_->format_used = 0;
+    _m_header_->slot_count = slot_count;
+    _m_header_->base_mono_ns = get_clock_ns( CLOCK_MONOTONIC );
+    _m_header_->base_real_ns = get_clock_ns( CLOCK_REALTIME );
+    strncpy( _m_header_->tag, LOGGER_TAG, sizeof(_m_header_->tag) - 1 );
+    std::atomic_thread_fence( std::memory_order_release );
+    memcpy( _m_header_->magic, MAGIC, sizeof(_m_header_->magic) );         // header is valid.
+    return true;
+}
+
+void CBinaryLog::close(void) {
+    if( _m_map_ != NULL ) {
+        msync( _m_map_, _m_map_size_, MS_SYNC );
+        munmap( _m_map_, _m_map_size_ );
+    }
+
+    if( _m_fd_ >= 0 ) {
+        ::close( _m_fd_ );
+    }
+
+    _m_fd_ = -1;
+    _m_map_ = NULL;
+    _m_map_size_ = 0;
+    _m_header_ = NULL;
+    _m_formats_ = NULL;
+    _m_slots_ = NULL;
+    _mm_sites_.clear();
+}
+
+void CBinaryLog::write( const CAsyncLogger::CRecord& record ) {
+    if( is_opened() == false ) {
+        return;
+    }
+
+    uint64_t seq = ++_m_seq_;
+    CSlot& slot = _m_slots_[(seq - 1) % _m_header_->slot_count];
+
+    // seq is written at last, so decoder skips slot that is torn by crash.
+    slot.seq = 0;
+    std::atomic_thread_fence( std::memory_order_release );
+    slot.time_ns = record.time_ns;
+    slot.site = get_site( record.fmt );
+    slot.length = record.length;
+    slot.level = static_cast<uint8_t>(record.level);
+    slot.truncated = record.truncated ? 1 : 0;
+    memcpy( slot.args, record.args, record.length );     // only used bytes, to dirty less pages.
+    std::atomic_thread_fence( std::memory_order_release );
+    slot.seq = seq;
+}
+
+void CBinaryLog::sync(void) {
+    if( is_opened() == true ) {
+        msync( _m_map_, _m_map_size_, MS_ASYNC );
+    }
+}
+
+/****
+ * Reader (for decoder)
+ */
+bool CBinaryLog::load( const std::string& path, CHeader& header,
+                       std::vector<std::string>& formats, std::vector<CSlot>& slots, std::string& error ) {
+    std::ifstream file( path, std::ios::binary );
+
+    formats.clear();
+    slots.clear();
+    if( file.is_open() == false ) {
+        error = "can not open " + path;
+        return false;
+    }
+
+    if( file.read(reinterpret_cast<char*>(&header), sizeof(header)).good() == false ||
+        strncmp(header.magic, MAGIC, sizeof(header.magic)) != 0 ) {
+        error = "not binary log-file. (invalid magic)";
+        return false;
+    }
+
+    if( header.version != VERSION || header.slot_size != sizeof(CSlot) ||
+        header.args_size != CAsyncLogger::ARGS_SIZE || header.format_size != FORMAT_SIZE ||
+        header.format_count != FORMAT_COUNT || header.format_used > FORMAT_COUNT ) {
+        error = "not supported layout. (version=" + std::to_string(header.version) + ")";
+        return false;
+    }
+
+    std::vector<char> format( FORMAT_SIZE );
+    file.seekg( HEADER_SIZE );
+    for( uint32_t site=0; site < header.format_used; site++ ) {
+        if( file.read(format.data(), FORMAT_SIZE).good() == false ) {
+            error = "format-table is truncated.";
+            return false;
+        }
+        format[FORMAT_SIZE - 1] = '\0';
+        formats.push_back( format.data() );
+    }
+
+    CSlot slot;
+    file.seekg( HEADER_SIZE + FORMAT_SIZE * FORMAT_COUNT );
+    for( uint32_t index=0; index < header.slot_count; index++ ) {
+        if( file.read(reinterpret_cast<char*>(&slot), sizeof(slot)).good() == false ) {
+            break;      // file is truncated. (Ex: copied while writing) remained slots are decoded.
+        }
+
+        if( slot.seq != 0 && slot.length <= CAsyncLogger::ARGS_SIZE ) {
+            slots.push_back( slot );
+        }
+    }
+
+    std::sort( slots.begin(), slots.end(), [](const CSlot& a, const CSlot& b) {
+        return a.seq < b.seq;
+    } );
+    return true;
+}
+
+void CBinaryLog::to_record( const CSlot& slot, const char* fmt, CAsyncLogger::CRecord& record ) {
+    record.fmt = (fmt != NULL ? fmt : FMT_UNKNOWN_SITE);
+    record.time_ns = slot.time_ns;
+    record.level = slot.level;
+    record.length = std::min<uint16_t>( slot.length, CAsyncLogger::ARGS_SIZE );
+    record.truncated = (slot.truncated != 0);
+    memcpy( record.args, slot.args, record.length );
+}
+
+
+/*********************************
+ * Definition of Private Function.
+ */
+size_t CBinaryLog::get_file_size( uint32_t slot_count ) {
+    return HEADER_SIZE + FORMAT_SIZE * FORMAT_COUNT + sizeof(CSlot) * static_cast<size_t>(slot_count);
+}
+
+uint32_t CBinaryLog::get_site( const char* fmt ) {
+    auto itr = _mm_sites_.find( fmt );
+    if( itr != _mm_sites_.end() ) {
+        return itr->second;
+    }
+
+    uint32_t site = _m_header_->format_used;
+    if( site >= FORMAT_COUNT ) {
+        return SITE_NONE;
+    }
+
+    // format-string is longer than FORMAT_SIZE, then it's cut. (remained arguments are not printed.)
+    strncpy( _m_formats_ + FORMAT_SIZE * site, fmt, FORMAT_SIZE - 1 );
+    std::atomic_thread_fence( std::memory_order_release );
+    _m_header_->format_used = site + 1;
+    _mm_sites_[fmt] = site;
+    return site;
+}
+
+
+}   // namespace logger_pkg
@@ -0,0 +1,140 @@
+#ifndef _BINARY_LOG_BY_KES_H_
+#define _BINARY_LOG_BY_KES_H_
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+
+#include <async_logger_kes.h>
+
+namespace logger_pkg {
+
+
+/***
+ * Binary log-file. (deferred-format capture of CAsyncLogger, if LOG_BINARY_FILE env is set.)
+ *  - File is memory-mapped & it's overwritten circularly. (fixed-size slot per record)
+ *  - Slot keeps call-site id + monotonic timestamp + raw arguments. Nothing is formatted on target.
+ *  - Format-string of call-site is written once into format-table of the file,
+ *    so the file is decoded without matching executable. (Ex: log_decoder tool on host)
+ *  - Layout : [CHeader : HEADER_SIZE][format-table : FORMAT_SIZE * FORMAT_COUNT][CSlot * slot_count]
+ *    Byte-order is native. (little-endian at all of supported targets)
+ ***/
+class CBinaryLog {
+public:
+    static constexpr const char* MAGIC = "KESBLOG";
+    static constexpr uint32_t VERSION = 1;
+    static constexpr size_t HEADER_SIZE = 4096;
+    static constexpr size_t FORMAT_SIZE = 256;          // bytes per format-string. (include NULL)
+    static constexpr uint32_t FORMAT_COUNT = 1024;      // max count of call-sites.
+    static constexpr uint32_t SITE_NONE = 0xFFFFFFFF;   // format-table is full.
+    static constexpr uint32_t DEFAULT_SLOT_COUNT = 65536;
+    static constexpr const char* ENV_FILE = "LOG_BINARY_FILE";
+    static constexpr const char* ENV_SLOTS = "LOG_BINARY_SLOTS";
+    static constexpr const char* OLD_SUFFIX = ".old";   // file of previous run is kept with this suffix.
+
+    class CHeader {
+    public:
+        char magic[8];
+
+        uint32_t version;
+
+        uint32_t slot_size;
+
+        uint32_t args_size;
+
+        uint32_t format_size;
+
+        uint32_t format_count;
+
+        uint32_t format_used;       // updated by writer.
+
+        uint32_t slot_count;
+
+        uint32_t reserved;
+
+        uint64_t base_mono_ns;      // CLOCK_MONOTONIC at open. (for converting time_ns to real-time)
+
+        uint64_t base_real_ns;      // CLOCK_REALTIME at open.
+
+        char tag[32];               // LOGGER_TAG of writer process.
+    };
+
+    class CSlot {
+    public:
+        uint64_t seq;               // 1 ~ (0 : empty or being written)
+
+        uint64_t time_ns;           // CLOCK_MONOTONIC
+
+        uint32_t site;              // index of format-table.
+
+        uint16_t length;            // used bytes of args.
+
+        uint8_t level;
+
+        uint8_t truncated;
+
+        char args[CAsyncLogger::ARGS_SIZE];
+    };
+
+public:
+    CBinaryLog(void);
+
+    ~CBinaryLog(void);
+
+    /** Create & map log-file. (Existing file is renamed with OLD_SUFFIX.) */
+    bool open( const std::string& path, uint32_t slot_count );
+
+    void close(void);
+
+    bool is_opened(void) const { return _m_map_ != NULL; }
+
+    /** It must be called by only one thread. (writer-thread of CAsyncLogger) */
+    void write( const CAsyncLogger::CRecord& record );
+
+    /** Request write-back of dirty pages. (Non-Blocking) */
+    void sync(void);
+
+    /****
+     * Reader (for decoder)
+     */
+    /** Load format-table & valid slots in order of seq. */
+    static bool load( const std::string& path, CHeader& header,
+                      std::vector<std::string>& formats, std::vector<CSlot>& slots, std::string& error );
+
+    /** Slot -> Record that can be formatted by CAsyncLogger::format(). */
+    static void to_record( const CSlot& slot, const char* fmt, CAsyncLogger::CRecord& record );
+
+private:
+    CBinaryLog(const CBinaryLog&) = delete;             // copy constructor
+    CBinaryLog& operator=(const CBinaryLog&) = delete;  // copy operator
+    CBinaryLog(CBinaryLog&&) = delete;                  // move constructor
+    CBinaryLog& operator=(CBinaryLog&&) = delete;       // move operator
+
+    static size_t get_file_size( uint32_t slot_count );
+
+    uint32_t get_site( const char* fmt );
+
+private:
+    int _m_fd_;
+
+    char* _m_map_;
+
+    size_t _m_map_size_;
+
+    CHeader* _m_header_;
+
+    char* _m_formats_;
+
+    CSlot* _m_slots_;
+
+    uint64_t _m_seq_;
+
+    std::unordered_map<const char*, uint32_t> _mm_sites_;   // format-pointer -> site. (format is string-literal)
+
+};
+
+
+}   // namespace logger_pkg
+
+#endif // _BINARY_LOG_BY_KES_H_
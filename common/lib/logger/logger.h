@@ -12,7 +12,9 @@
 #include <log_level.h>
 
 
-#ifdef LOG_MODE_STDOUT
+#if defined(LOG_ASYNC_ENABLE) && defined(__cplusplus)
+    #include "async/logger.h"
+#elif defined(LOG_MODE_STDOUT)
     #include "stdout/logger.h"
 #else
     #ifdef __cplusplus
@@ -2,6 +2,7 @@
 #define _CLASS_SQLITE_DATABASE_DEFINITION_H_
 
 #include <vector>
+#include <algorithm>
 
 #include <sqlite3_kes.h>
 
@@ -10,8 +11,15 @@ namespace db_pkg {
 
 class CDBsqlite: public IDBsqlite3 {
 public:
-    CDBsqlite( const std::string db_path, const char* const* tables_model )
-    : db_pkg::IDBsqlite3(db_path) {
+    /***
+     * tables_model   : NULL-terminated list of "table(columns...)".
+     * indexes_model  : NULL-terminated list of "index-name ON table(columns...)". (Option)
+     * schema_version : version of tables_model & indexes_model. It's saved in 'PRAGMA user_version' of DB-file,
+     *                  and tables/indexes are migrated when the version of DB-file is older than it.
+     ***/
+    CDBsqlite( const std::string db_path, const char* const* tables_model, 
+               const char* const* indexes_model=NULL, int schema_version=0 )
+    : db_pkg::IDBsqlite3(db_path), _m_schema_version_(schema_version) {
         if( tables_model == NULL ) {
             throw std::invalid_argument("tables_model is NULL.");
         }
@@ -23,10 +31,15 @@ public:
         if( _m_tables_model_.size() <= 0 ) {
             throw std::invalid_argument("tables_model is Empty.");
         }
+
+        for( int i=0; indexes_model != NULL && indexes_model[i] != NULL; i++ ) {
+            _m_indexes_model_.push_back( std::string(indexes_model[i]) );
+        }
     }
 
     ~CDBsqlite( void ) {
         _m_tables_model_.clear();
+        _m_indexes_model_.clear();
     }
 
 protected:
@@ -35,6 +48,157 @@ protected:
         for( auto itr=_m_tables_model_.begin(); itr!=_m_tables_model_.end(); itr++ ) {
             execute_query( "CREATE TABLE IF NOT EXISTS " + *itr + ";" );
         }
+
+        int version = get_user_version();
+        if( version < _m_schema_version_ ) {
+            std::cout << "CDBsqlite: migrate schema-version " << version << " -> " << _m_schema_version_ << std::endl;
+            migrate_table_model();
+            migrate_index_model();
+        }
+        else {
+            if( version > _m_schema_version_ ) {
+                std::cout << "CDBsqlite: schema-version(" << version << ") of DB-file is newer than " << _m_schema_version_ << std::endl;
+            }
+            create_index_model();
+        }
+    }
+
+private:
+    static std::string get_index_name( const std::string& index_model ) {
+        return index_model.substr( 0, index_model.find(" ON ") );
+    }
+
+    static std::string get_table_name( const std::string& table_model ) {
+        return table_model.substr( 0, table_model.find("(") );
+    }
+
+    std::vector<std::string> get_columns( const std::string& table ) {
+        std::vector<std::string> columns;
+        TCBfetch lamda_func = [&columns](const CStatement& stmt) -> void {
+            columns.push_back( stmt.column_text(1) );
+        };
+
+        if( execute_statement( "PRAGMA table_info(" + table + ");", TVvalue(), &lamda_func ) != SQLITE_OK ) {
+            throw std::runtime_error("Loading columns of " + table + " is failed.");
+        }
+        return columns;
+    }
+
+    /***
+     * Rebuild tables that definition of DB-file is different with model. (Ex: constraint is changed.)
+     * Columns that exist in both of old and new table are copied. Indexes are re-created by migrate_index_model().
+     ***/
+    void migrate_table_model( void ) {
+        for( auto itr=_m_tables_model_.begin(); itr!=_m_tables_model_.end(); itr++ ) {
+            std::string sql;
+            std::string copied;
+            std::string table = get_table_name(*itr);
+            std::string temp = table + "_migrated";
+            TCBfetch lamda_func = [&sql](const CStatement& stmt) -> void {
+                sql = stmt.column_text(0);
+            };
+
+            // sqlite keeps definition as "CREATE TABLE " + model. (name is quoted, if the table was renamed by rebuilding.)
+            if( query_fetch( "sql FROM sqlite_master WHERE type = 'table' AND name = ?", { CValue(table) }, lamda_func ) != SQLITE_OK ) {
+                throw std::runtime_error("Loading definition of " + table + " is failed.");
+            }
+
+            if( sql.empty() == true || sql == "CREATE TABLE " + *itr ||
+                sql == "CREATE TABLE \"" + table + "\"" + itr->substr(table.length()) ) {
+                continue;
+            }
+
+            std::cout << "CDBsqlite: rebuild table(" << table << ")" << std::endl;
+            if( begin_transaction() != SQLITE_OK ) {
+                throw std::runtime_error("begin_transaction is failed.");
+            }
+
+            try {
+                if( execute_query( "DROP TABLE IF EXISTS " + temp + ";" ) != SQLITE_OK ||
+                    execute_query( "CREATE TABLE " + temp + itr->substr(table.length()) + ";" ) != SQLITE_OK ) {
+                    throw std::runtime_error("Creating " + temp + " is failed.");
+                }
+
+                std::vector<std::string> olds = get_columns( table );
+                std::vector<std::string> news = get_columns( temp );
+                for( auto itr_col=news.begin(); itr_col!=news.end(); itr_col++ ) {
+                    if( std::find(olds.begin(), olds.end(), *itr_col) != olds.end() ) {
+                        copied += (copied.empty() ? "" : ",") + *itr_col;
+                    }
+                }
+
+                if( execute_query( "INSERT INTO " + temp + "(" + copied + ") SELECT " + copied + " FROM " + table + ";" ) != SQLITE_OK ||
+                    execute_query( "DROP TABLE " + table + ";" ) != SQLITE_OK ||
+                    execute_query( "ALTER TABLE " + temp + " RENAME TO " + table + ";" ) != SQLITE_OK ) {
+                    throw std::runtime_error("Rebuilding " + table + " is failed.");
+                }
+            }
+            catch( const std::exception& e ) {
+                rollback_transaction();
+                throw e;
+            }
+
+            if( commit_transaction() != SQLITE_OK ) {
+                throw std::runtime_error("commit_transaction is failed.");
+            }
+        }
+    }
+
+    void create_index_model( void ) {
+        for( auto itr=_m_indexes_model_.begin(); itr!=_m_indexes_model_.end(); itr++ ) {
+            if( execute_query( "CREATE INDEX IF NOT EXISTS " + *itr + ";" ) != SQLITE_OK ) {
+                throw std::runtime_error("Creating index(" + *itr + ") is failed.");
+            }
+        }
+    }
+
+    /** Drop indexes that are not in model, create new indexes and update user_version in one transaction. */
+    void migrate_index_model( void ) {
+        std::vector<std::string> indexes;
+        std::vector<std::string> obsoletes;
+
+        for( auto itr=_m_indexes_model_.begin(); itr!=_m_indexes_model_.end(); itr++ ) {
+            indexes.push_back( get_index_name(*itr) );
+        }
+
+        // auto-index of UNIQUE/PRIMARY KEY has NULL sql, so it's excluded.
+        TCBfetch lamda_func = [&indexes, &obsoletes](const CStatement& stmt) -> void {
+            std::string name = stmt.column_text(0);
+            if( std::find(indexes.begin(), indexes.end(), name) == indexes.end() ) {
+                obsoletes.push_back( name );
+            }
+        };
+
+        if( query_fetch( "name FROM sqlite_master WHERE type = 'index' AND sql IS NOT NULL", TVvalue(), lamda_func ) != SQLITE_OK ) {
+            throw std::runtime_error("Loading index-list is failed.");
+        }
+
+        if( begin_transaction() != SQLITE_OK ) {
+            throw std::runtime_error("begin_transaction is failed.");
+        }
+
+        try {
+            for( auto itr=obsoletes.begin(); itr!=obsoletes.end(); itr++ ) {
+                std::cout << "CDBsqlite: drop obsolete index(" << *itr << ")" << std::endl;
+                if( execute_query( "DROP INDEX IF EXISTS " + *itr + ";" ) != SQLITE_OK ) {
+                    throw std::runtime_error("Dropping index(" + *itr + ") is failed.");
+                }
+            }
+
+            create_index_model();
+
+            if( set_user_version(_m_schema_version_) != SQLITE_OK ) {
+                throw std::runtime_error("Updating user_version is failed.");
+            }
+        }
+        catch( const std::exception& e ) {
+            rollback_transaction();
+            throw e;
+        }
+
+        if( commit_transaction() != SQLITE_OK ) {
+            throw std::runtime_error("commit_transaction is failed.");
+        }
     }
 
 private:
@@ -47,6 +211,10 @@ private:
 private:
     std::vector<std::string> _m_tables_model_;
 
+    std::vector<std::string> _m_indexes_model_;
+
+    int _m_schema_version_;
+
 };
 
 
@@ -8,6 +8,155 @@ namespace db_pkg {
 
 std::map<std::string /*db-path*/, std::mutex /*locker*/> IDBsqlite3::_mtx_lock_;
 
+constexpr size_t IDBsqlite3::MAX_STMT_CACHE;
+
+
+/**********************************
+ * CStatement Function Definition.
+ ***/
+IDBsqlite3::CStatement::CStatement( TdbInst* db, const std::string& query, bool persistent ) {
+    _m_stmt_ = NULL;
+    _m_in_use_ = false;
+
+    try {
+        int rc = SQLITE_ERROR;
+        unsigned int flags = persistent ? SQLITE_PREPARE_PERSISTENT : 0;
+
+        if( db == NULL ) {
+            throw std::invalid_argument("DB-instance is NULL.");
+        }
+
+        rc = sqlite3_prepare_v3(db, query.c_str(), static_cast<int>(query.length() + 1), flags, &_m_stmt_, NULL);
+        if( rc != SQLITE_OK || _m_stmt_ == NULL ) {
+            std::string err = "Preparing(" + query + ") is failed. (rc=" + std::to_string(rc) + "): " + std::string( sqlite3_errmsg(db) );
+            throw std::runtime_error(err);
+        }
+    }
+    catch( const std::exception& e ) {
+        LOGERR("%s", e.what());
+        throw e;
+    }
+}
+
+IDBsqlite3::CStatement::~CStatement( void ) {
+    if( _m_stmt_ != NULL ) {
+        sqlite3_finalize(_m_stmt_);
+        _m_stmt_ = NULL;
+    }
+}
+
+bool IDBsqlite3::CStatement::acquire( void ) {
+    return (_m_in_use_.exchange(true) == false);
+}
+
+void IDBsqlite3::CStatement::release( void ) {
+    sqlite3_reset(_m_stmt_);
+    sqlite3_clear_bindings(_m_stmt_);
+    _m_in_use_ = false;
+}
+
+void IDBsqlite3::CStatement::bind( const TVvalue& values ) {
+    try {
+        int rc = SQLITE_OK;
+
+        if( static_cast<int>(values.size()) != sqlite3_bind_parameter_count(_m_stmt_) ) {
+            std::string err = "Count of bind-values(" + std::to_string(values.size()) + ") is not matched with parameters(" 
+                            + std::to_string(sqlite3_bind_parameter_count(_m_stmt_)) + ").";
+            throw std::invalid_argument(err);
+        }
+
+        for( int i=0; i < static_cast<int>(values.size()) && rc == SQLITE_OK; i++ ) {
+            const CValue& value = values[i];
+
+            switch( value.type() ) {
+            case CValue::Ttype::ENUM_INTEGER:
+                rc = sqlite3_bind_int64(_m_stmt_, i+1, value.integer());
+                break;
+            case CValue::Ttype::ENUM_REAL:
+                rc = sqlite3_bind_double(_m_stmt_, i+1, value.real());
+                break;
+            case CValue::Ttype::ENUM_TEXT:
+                rc = sqlite3_bind_text(_m_stmt_, i+1, value.text().data(), static_cast<int>(value.text().length()), SQLITE_STATIC);
+                break;
+            default:
+                rc = sqlite3_bind_null(_m_stmt_, i+1);
+                break;
+            }
+        }
+
+        if( rc != SQLITE_OK ) {
+            std::string err = "Binding values is failed. (rc=" + std::to_string(rc) + "): " 
+                            + std::string( sqlite3_errmsg(sqlite3_db_handle(_m_stmt_)) );
+            throw std::runtime_error(err);
+        }
+    }
+    catch( const std::exception& e ) {
+        LOGERR("%s", e.what());
+        throw e;
+    }
+}
+
+int IDBsqlite3::CStatement::step( void ) {
+    int rc = SQLITE_ERROR;
+
+    while( (rc = sqlite3_step(_m_stmt_)) == SQLITE_BUSY ) {
+        LOGW("100ms sleep because of SQLITE_BUSY.");
+        usleep(100000);     // delay 100 ms
+        sqlite3_reset(_m_stmt_);    // bindings are kept.
+    }
+
+    return rc;
+}
+
+int IDBsqlite3::CStatement::column_count( void ) const {
+    return sqlite3_column_count(_m_stmt_);
+}
+
+const char* IDBsqlite3::CStatement::column_name( int col ) const {
+    return sqlite3_column_name(_m_stmt_, col);
+}
+
+int IDBsqlite3::CStatement::column_type( int col ) const {
+    return sqlite3_column_type(_m_stmt_, col);
+}
+
+int64_t IDBsqlite3::CStatement::column_integer( int col ) const {
+    return sqlite3_column_int64(_m_stmt_, col);
+}
+
+double IDBsqlite3::CStatement::column_real( int col ) const {
+    return sqlite3_column_double(_m_stmt_, col);
+}
+
+std::string IDBsqlite3::CStatement::column_text( int col ) const {
+    const unsigned char* text = sqlite3_column_text(_m_stmt_, col);
+    if( text == NULL ) {
+        return std::string();
+    }
+    return std::string( reinterpret_cast<const char*>(text), sqlite3_column_bytes(_m_stmt_, col) );
+}
+
+std::shared_ptr<IDBsqlite3::Trecord> IDBsqlite3::CStatement::make_record( void ) const {
+    std::shared_ptr<Trecord> record;
+
+    try {
+        record = std::make_shared<Trecord>();
+        if( record.get() == NULL ) {
+            throw std::runtime_error("record memory-allocation is failed.");
+        }
+
+        for( int i = 0; i < column_count(); i++ ) {
+            (*record)[ column_name(i) ] = (column_type(i) == SQLITE_NULL) ? "NULL" : column_text(i);
+        }
+    }
+    catch( const std::exception& e ) {
+        LOGERR("%s", e.what());
+        throw e;
+    }
+
+    return record;
+}
+
 /**********************************
  * Public Function Definition.
  ***/
@@ -92,6 +241,126 @@ std::shared_ptr<IDBsqlite3::TVrecord> IDBsqlite3::query_select( std::string cont
 }
 
 
+int IDBsqlite3::query_insert( std::string context, const TVvalue& values ) {
+    // context sample: "{table}({key01},{key02},{key0x}) VALUES(?,?,?)"
+    return execute_statement( "INSERT INTO " + context + ";", values );
+}
+
+int IDBsqlite3::query_update( std::string context, const TVvalue& values ) {
+    // context sample: "{table} SET {key01} = ?, {key02} = ? WHERE id = ?"
+    return execute_statement( "UPDATE " + context + ";", values );
+}
+
+int IDBsqlite3::query_delete( std::string context, const TVvalue& values ) {
+    // context sample: "{table} WHERE id = ?"
+    return execute_statement( "DELETE FROM " + context + ";", values );
+}
+
+int IDBsqlite3::query_select( std::string context, const TVvalue& values, TCBselect func ) {
+    TCBfetch lamda_fetch = [&func](const CStatement& stmt) -> void {
+        auto record = stmt.make_record();
+        func( record );
+    };
+
+    // context sample: "* FROM {table} WHERE id = ?"
+    return execute_statement( "SELECT " + context + ";", values, &lamda_fetch );
+}
+
+int IDBsqlite3::query_fetch( std::string context, const TVvalue& values, TCBfetch func ) {
+    // context sample: "{key01},{key02} FROM {table} WHERE id = ?"
+    return execute_statement( "SELECT " + context + ";", values, &func );
+}
+
+int IDBsqlite3::attach_database( const std::string& db_path, const std::string& schema ) {
+    // schema-name can not be bound, so it is used only for internal constant name.
+    return execute_statement( "ATTACH DATABASE ? AS " + schema + ";", {CValue(db_path)} );
+}
+
+int IDBsqlite3::begin_transaction( void ) {
+    int rc = SQLITE_ERROR;
+
+    _mtx_transaction_.lock();       // It's unlocked by commit/rollback.
+    rc = execute_query( "BEGIN IMMEDIATE;" );
+    if( rc != SQLITE_OK ) {
+        _mtx_transaction_.unlock();
+    }
+    return rc;
+}
+
+int IDBsqlite3::commit_transaction( void ) {
+    int rc = execute_query( "COMMIT;" );
+    if( rc != SQLITE_OK ) {
+        rc = rollback_transaction();
+        return (rc == SQLITE_OK ? SQLITE_ABORT : rc);
+    }
+
+    _mtx_transaction_.unlock();
+    return rc;
+}
+
+int IDBsqlite3::rollback_transaction( void ) {
+    int rc = execute_query( "ROLLBACK;" );
+    _mtx_transaction_.unlock();
+    return rc;
+}
+
+int IDBsqlite3::changes( void ) {
+    if( _m_inst_ == NULL ) {
+        return 0;
+    }
+    return sqlite3_changes(_m_inst_);
+}
+
+int IDBsqlite3::get_user_version( void ) {
+    int version = 0;
+    TCBfetch lamda_func = [&version](const CStatement& stmt) -> void {
+        version = static_cast<int>( stmt.column_integer(0) );
+    };
+
+    if( execute_statement( "PRAGMA user_version;", TVvalue(), &lamda_func ) != SQLITE_OK ) {
+        throw std::runtime_error("Reading user_version is failed.");
+    }
+    return version;
+}
+
+int IDBsqlite3::set_user_version( int version ) {
+    // PRAGMA value can not be bound.
+    return execute_query( "PRAGMA user_version = " + std::to_string(version) + ";" );
+}
+
+int IDBsqlite3::explain_query_plan( const std::string& query, const TVvalue& values, std::vector<std::string>& details ) {
+    int rc = SQLITE_ERROR;
+
+    if( _m_inst_ == NULL ) {
+        LOGERR("DB-instance is NULL.");
+        return rc;
+    }
+
+    std::lock_guard<std::recursive_mutex> guard(_mtx_transaction_);
+    try {
+        // It's used only for diagnosis, so statement is not cached.
+        CStatement stmt(_m_inst_, "EXPLAIN QUERY PLAN " + query, false);
+        stmt.acquire();
+        stmt.bind(values);
+
+        // columns of query-plan: id, parent, notused, detail
+        while( (rc = stmt.step()) == SQLITE_ROW ) {
+            details.push_back( stmt.column_text(3) );
+        }
+        stmt.release();
+
+        if( rc == SQLITE_DONE ) {
+            rc = SQLITE_OK;
+        }
+    }
+    catch( const std::exception& e ) {
+        LOGERR("%s", e.what());
+        rc = SQLITE_ERROR;
+    }
+    return rc;
+}
+
+
 /**********************************
  * Protected Function Definition.
  ***/
@@ -104,6 +373,7 @@ int IDBsqlite3::execute_query(const std::string&& query, TCBselect* pfunc) {
         return rc;
     }
 
+    std::lock_guard<std::recursive_mutex> guard(_mtx_transaction_);
     do {
         rc = sqlite3_exec(_m_inst_, query.c_str(), _m_cb_onselect_, (void*)pfunc, &zErrMsg);    // Block function until done calling call-back.
         if( rc == SQLITE_BUSY ) {
@@ -129,6 +399,7 @@ int IDBsqlite3::execute_query(const std::string& query, TCBselect* pfunc) {
         return rc;
     }
 
+    std::lock_guard<std::recursive_mutex> guard(_mtx_transaction_);
     do {
         rc = sqlite3_exec(_m_inst_, query.c_str(), _m_cb_onselect_, (void*)pfunc, &zErrMsg);    // Block function until done calling call-back.
         if( rc == SQLITE_BUSY ) {
@@ -146,6 +417,46 @@ int IDBsqlite3::execute_query(const std::string& query, TCBselect* pfunc) {
 }
 
 
+int IDBsqlite3::execute_statement(const std::string& query, const TVvalue& values, TCBfetch* pfunc) {
+    int rc = SQLITE_ERROR;
+    std::shared_ptr<CStatement> stmt;
+
+    if( _m_inst_ == NULL ) {
+        LOGERR("DB-instance is NULL.");
+        return rc;
+    }
+
+    std::lock_guard<std::recursive_mutex> guard(_mtx_transaction_);
+    try {
+        stmt = get_statement(query);
+        stmt->bind(values);
+
+        while( (rc = stmt->step()) == SQLITE_ROW ) {
+            if( pfunc != NULL ) {
+                (*pfunc)( *stmt );      // call custom-function.
+            }
+        }
+
+        if( rc == SQLITE_DONE ) {
+            rc = SQLITE_OK;
+        }
+        else {
+            LOGERR("Executing(%s) is failed.", query.data());
+            LOGERR("SQL error(rc=%d): %s", rc, sqlite3_errmsg(_m_inst_));
+        }
+    }
+    catch( const std::exception& e ) {
+        LOGERR("%s", e.what());
+        rc = SQLITE_ERROR;
+    }
+
+    if( stmt.get() != NULL ) {
+        stmt->release();
+    }
+    return rc;
+}
+
+
 /**********************************
  * Private Function Definition.
  ***/
@@ -212,12 +523,49 @@ void IDBsqlite3::open(const std::string& db_path) {
 }
 
 void IDBsqlite3::exit(void) {
+    clear_statements();     // All statements have to be finalized before closing DB.
     if( _m_inst_ != NULL ) {
         sqlite3_close(_m_inst_);
     }
     clear();
 }
 
+std::shared_ptr<IDBsqlite3::CStatement> IDBsqlite3::get_statement(const std::string& query) {
+    std::shared_ptr<CStatement> stmt;
+
+    try {
+        std::lock_guard<std::mutex> guard(_mtx_stmt_cache_);
+
+        auto itr = _mm_stmt_cache_.find(query);
+        if( itr != _mm_stmt_cache_.end() && itr->second->acquire() == true ) {
+            return itr->second;
+        }
+
+        // If statement is not cached or is used by another one, then prepare new statement.
+        bool cachable = (itr == _mm_stmt_cache_.end() && _mm_stmt_cache_.size() < MAX_STMT_CACHE);
+        stmt = std::make_shared<CStatement>(_m_inst_, query, cachable);
+        if( stmt.get() == NULL ) {
+            throw std::runtime_error("statement memory-allocation is failed.");
+        }
+        stmt->acquire();
+
+        if( cachable == true ) {
+            _mm_stmt_cache_[query] = stmt;
+        }
+    }
+    catch( const std::exception& e ) {
+        LOGERR("%s", e.what());
+        throw e;
+    }
+
+    return stmt;
+}
+
+void IDBsqlite3::clear_statements(void) {
+    std::lock_guard<std::mutex> guard(_mtx_stmt_cache_);
+    _mm_stmt_cache_.clear();
+}
+
 int IDBsqlite3::callback_oncommit(TdbInst* db, const char* source, int pages) {
     try {
         const std::string src_name = std::string(source);
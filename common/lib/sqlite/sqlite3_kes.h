@@ -6,9 +6,11 @@
 #include <map>
 #include <vector>
 #include <mutex>
+#include <atomic>
 #include <memory>
 #include <iostream>
 #include <functional>
+#include <type_traits>
 
 #include <sqlite3.h>
 
@@ -24,6 +26,96 @@ public:
 protected:
     using TdbInst = sqlite3;
 
+public:
+    /** Value to bind at '?' parameter of prepared-statement. */
+    class CValue {
+    public:
+        using Ttype = enum class enum_value_type: uint8_t { ENUM_NULL=0, ENUM_INTEGER=1, ENUM_REAL=2, ENUM_TEXT=3 };
+
+        CValue( void )
+        : _m_type_(Ttype::ENUM_NULL), _m_integer_(0), _m_real_(0.0) {}
+
+        template <typename T, typename std::enable_if<std::is_integral<T>::value, int>::type = 0>
+        CValue( T value )
+        : _m_type_(Ttype::ENUM_INTEGER), _m_integer_(static_cast<int64_t>(value)), _m_real_(0.0) {}
+
+        template <typename T, typename std::enable_if<std::is_floating_point<T>::value, int>::type = 0>
+        CValue( T value )
+        : _m_type_(Ttype::ENUM_REAL), _m_integer_(0), _m_real_(static_cast<double>(value)) {}
+
+        CValue( std::string value )
+        : _m_type_(Ttype::ENUM_TEXT), _m_integer_(0), _m_real_(0.0), _m_text_(std::move(value)) {}
+
+        CValue( const char* value )
+        : _m_type_(Ttype::ENUM_TEXT), _m_integer_(0), _m_real_(0.0), _m_text_(value == NULL ? "" : value) {}
+
+        Ttype type( void ) const { return _m_type_; }
+
+        int64_t integer( void ) const { return _m_integer_; }
+
+        double real( void ) const { return _m_real_; }
+
+        const std::string& text( void ) const { return _m_text_; }
+
+    private:
+        Ttype _m_type_;
+
+        int64_t _m_integer_;
+
+        double _m_real_;
+
+        std::string _m_text_;
+
+    };
+
+    using TVvalue = std::vector<CValue>;
+
+    class CStatement;
+    using TCBfetch = std::function<void(const CStatement&)>;    // call-back per row with typed column reads.
+
+    /** Prepared-statement. (It is cached per SQL-text by IDBsqlite3) */
+    class CStatement {
+    public:
+        CStatement( TdbInst* db, const std::string& query, bool persistent );
+
+        ~CStatement( void );
+
+        bool acquire( void );       // return false, if statement is already used by another one.
+
+        void release( void );       // reset statement & clear bindings for next use.
+
+        void bind( const TVvalue& values );
+
+        int step( void );           // return SQLITE_ROW / SQLITE_DONE / error-code.
+
+        int column_count( void ) const;
+
+        const char* column_name( int col ) const;
+
+        int column_type( int col ) const;
+
+        int64_t column_integer( int col ) const;
+
+        double column_real( int col ) const;
+
+        std::string column_text( int col ) const;
+
+        std::shared_ptr<Trecord> make_record( void ) const;
+
+    private:
+        CStatement(void) = delete;
+        CStatement(const CStatement&) = delete;             // copy constructor
+        CStatement& operator=(const CStatement&) = delete;  // copy operator
+        CStatement(CStatement&&) = delete;                  // move constructor
+        CStatement& operator=(CStatement&&) = delete;       // move operator
+
+    private:
+        sqlite3_stmt* _m_stmt_;
+
+        std::atomic<bool> _m_in_use_;
+
+    };
+
 public:
     static void regist_all_of_db( std::vector<std::string>& db_list ) {
         if( _mtx_lock_.size() != 0 ) {
@@ -53,6 +145,37 @@ public:
 
     std::shared_ptr<TVrecord> query_select( std::string context );
 
+    /** Queries with bound parameters. ('?' in context is replaced by values in order.) */
+    int query_insert( std::string context, const TVvalue& values );
+
+    int query_update( std::string context, const TVvalue& values );
+
+    int query_delete( std::string context, const TVvalue& values );
+
+    int query_select( std::string context, const TVvalue& values, TCBselect func );
+
+    int query_fetch( std::string context, const TVvalue& values, TCBfetch func );
+
+    /** Attach another DB-file to this connection as schema-name. */
+    int attach_database( const std::string& db_path, const std::string& schema );
+
+    /** Transaction: statements of other threads wait until commit/rollback. */
+    int begin_transaction( void );
+
+    int commit_transaction( void );
+
+    int rollback_transaction( void );
+
+    int changes( void );        // count of rows changed by last INSERT/UPDATE/DELETE.
+
+    /** Schema-version of DB-file. ('PRAGMA user_version') */
+    int get_user_version( void );
+
+    int set_user_version( int version );
+
+    /** Get 'detail' column of 'EXPLAIN QUERY PLAN {query}'. */
+    int explain_query_plan( const std::string& query, const TVvalue& values, std::vector<std::string>& details );
+
 protected:
     virtual int cb_oncommit(const std::string& src_name, int pages) {
         std::cout << "IDBsqlite3::cb_oncommit(" << src_name << ", " << pages << ") is called." << std::endl;
@@ -67,6 +190,8 @@ protected:
 
     int execute_query(const std::string& query, TCBselect* pfunc=NULL);
 
+    int execute_statement(const std::string& query, const TVvalue& values, TCBfetch* pfunc=NULL);
+
 private:
     IDBsqlite3(void) = delete;
 
@@ -81,6 +206,10 @@ private:
 
     void exit(void);
 
+    std::shared_ptr<CStatement> get_statement(const std::string& query);
+
+    void clear_statements(void);
+
     int callback_oncommit(TdbInst* db, const char* source, int pages);
 
     static int callback_onselect(TCBselect* pfunc, int argc, char **argv, char **azColName);
@@ -94,6 +223,16 @@ private:
 
     static std::map<std::string /*db-path*/, std::mutex /*locker*/> _mtx_lock_;
 
+    /* Cache of prepared-statements. */
+    std::map<std::string /*query*/, std::shared_ptr<CStatement>> _mm_stmt_cache_;
+
+    std::mutex _mtx_stmt_cache_;
+
+    /* Lock for transaction of this connection. */
+    std::recursive_mutex _mtx_transaction_;
+
+    static constexpr size_t MAX_STMT_CACHE = 64;
+
     friend void regist_all_of_db( std::vector<std::string>& db_list );
 
 };
@@ -0,0 +1,205 @@
+#ifndef _DEADLINE_QUEUE_BY_KES_H_
+#define _DEADLINE_QUEUE_BY_KES_H_
+
+#include <map>
+#include <vector>
+#include <mutex>
+#include <chrono>
+#include <utility>
+#include <algorithm>
+#include <condition_variable>
+
+namespace time_pkg {
+
+
+/***
+ * Keyed queue ordered by deadline. (seconds of Tclock: default is UTC-time)
+ *  - push/remove are O(log n), and each key has only one deadline. (push of same key re-schedules it.)
+ *  - wait_pop() blocks until the earliest deadline is reached,
+ *    and wakes up immediately when earlier deadline is pushed.
+ *  - Deadline that is relative to now (Ex: pulse-width) should use std::chrono::steady_clock,
+ *    so it's not affected by changing of wall-clock. (Ex: Time-Sync)
+ ***/
+template <typename Tkey, typename Tvalue, typename Tclock = std::chrono::system_clock>
+class CDeadlineQueue {
+public:
+    using Tentry = std::pair<Tkey, Tvalue>;
+    using TVentry = std::vector<Tentry>;
+
+private:
+    using TMorder = std::multimap<double /*deadline*/, Tkey>;
+    using TMentry = std::map<Tkey, std::pair<typename TMorder::iterator, Tvalue>>;
+
+public:
+    static constexpr double NONE_DEADLINE = -1.0;
+    static constexpr double MAX_WAIT_SEC = 1.0;     // re-check interval for wall-clock changing.
+
+public:
+    CDeadlineQueue( void ) : _m_is_continue_(true) {}
+
+    ~CDeadlineQueue( void ) {
+        stop();
+    }
+
+    static double now( void ) {
+        return std::chrono::duration<double>( Tclock::now().time_since_epoch() ).count();
+    }
+
+    /** Insert or re-schedule entry. return true, if the entry becomes the earliest one. */
+    bool push( const Tkey& key, double deadline, const Tvalue& value ) {
+        bool is_earliest = false;
+        {
+            std::lock_guard<std::mutex> guard(_mtx_queue_);
+            erase( key );
+
+            auto itr_order = _mm_order_.insert( std::make_pair(deadline, key) );
+            _mm_entry_.insert( std::make_pair(key, std::make_pair(itr_order, value)) );
+            is_earliest = (itr_order == _mm_order_.begin());
+        }
+
+        if( is_earliest == true ) {
+            _m_cv_.notify_all();
+        }
+        return is_earliest;
+    }
+
+    bool remove( const Tkey& key ) {
+        std::lock_guard<std::mutex> guard(_mtx_queue_);
+        return erase( key );
+    }
+
+    bool find( const Tkey& key, Tvalue& value, double* deadline=NULL ) {
+        std::lock_guard<std::mutex> guard(_mtx_queue_);
+        auto itr = _mm_entry_.find( key );
+        if( itr == _mm_entry_.end() ) {
+            return false;
+        }
+
+        value = itr->second.second;
+        if( deadline != NULL ) {
+            *deadline = itr->second.first->first;
+        }
+        return true;
+    }
+
+    double earliest( void ) {
+        std::lock_guard<std::mutex> guard(_mtx_queue_);
+        return _mm_order_.empty() ? NONE_DEADLINE : _mm_order_.begin()->first;
+    }
+
+    size_t size( void ) {
+        std::lock_guard<std::mutex> guard(_mtx_queue_);
+        return _mm_entry_.size();
+    }
+
+    void clear( void ) {
+        std::lock_guard<std::mutex> guard(_mtx_queue_);
+        _mm_order_.clear();
+        _mm_entry_.clear();
+    }
+
+    /** Pop all of entries that deadline is reached. (Non-Blocking) */
+    size_t pop_due( TVentry& entries ) {
+        std::lock_guard<std::mutex> guard(_mtx_queue_);
+        return pop_due_unlocked( entries, now() );
+    }
+
+    /** Pop all of entries regardless of deadline. (Non-Blocking: Ex) flush at termination.) */
+    size_t pop_all( TVentry& entries ) {
+        std::lock_guard<std::mutex> guard(_mtx_queue_);
+        size_t count = _mm_order_.size();
+
+        for( auto itr=_mm_order_.begin(); itr!=_mm_order_.end(); itr++ ) {
+            auto itr_entry = _mm_entry_.find( itr->second );
+            entries.push_back( std::make_pair(itr_entry->first, itr_entry->second.second) );
+        }
+        _mm_order_.clear();
+        _mm_entry_.clear();
+        return count;
+    }
+
+    /** Pop entries that deadline is reached. (Blocking until it exist or stop() is called.) */
+    bool wait_pop( TVentry& entries ) {
+        std::unique_lock<std::mutex> lk(_mtx_queue_);
+
+        while( _m_is_continue_ == true ) {
+            if( _mm_order_.empty() == true ) {
+                _m_cv_.wait( lk );
+                continue;
+            }
+
+            double cur_time = now();
+            double remain = _mm_order_.begin()->first - cur_time;
+            if( remain <= 0.0 ) {
+                pop_due_unlocked( entries, cur_time );
+                return true;
+            }
+
+            _m_cv_.wait_for( lk, std::chrono::duration<double>( std::min(remain, MAX_WAIT_SEC) ) );
+        }
+
+        return false;
+    }
+
+    /** Wake up waiter of wait_pop(), and it return false after it. */
+    void stop( void ) {
+        {
+            std::lock_guard<std::mutex> guard(_mtx_queue_);
+            _m_is_continue_ = false;
+        }
+        _m_cv_.notify_all();
+    }
+
+private:
+    CDeadlineQueue(const CDeadlineQueue&) = delete;             // copy constructor
+    CDeadlineQueue& operator=(const CDeadlineQueue&) = delete;  // copy operator
+    CDeadlineQueue(CDeadlineQueue&&) = delete;                  // move constructor
+    CDeadlineQueue& operator=(CDeadlineQueue&&) = delete;       // move operator
+
+    bool erase( const Tkey& key ) {
+        auto itr = _mm_entry_.find( key );
+        if( itr == _mm_entry_.end() ) {
+            return false;
+        }
+
+        _mm_order_.erase( itr->second.first );
+        _mm_entry_.erase( itr );
+        return true;
+    }
+
+    size_t pop_due_unlocked( TVentry& entries, double cur_time ) {
+        size_t count = 0;
+
+        while( _mm_order_.empty() == false && _mm_order_.begin()->first <= cur_time ) {
+            auto itr = _mm_entry_.find( _mm_order_.begin()->second );
+            entries.push_back( std::make_pair(itr->first, itr->second.second) );
+            _mm_order_.erase( _mm_order_.begin() );
+            _mm_entry_.erase( itr );
+            count++;
+        }
+        return count;
+    }
+
+private:
+    bool _m_is_continue_;
+
+    TMorder _mm_order_;
+
+    TMentry _mm_entry_;
+
+    std::mutex _mtx_queue_;
+
+    std::condition_variable _m_cv_;
+
+};
+
+template <typename Tkey, typename Tvalue, typename Tclock>
+constexpr double CDeadlineQueue<Tkey, Tvalue, Tclock>::NONE_DEADLINE;
+
+template <typename Tkey, typename Tvalue, typename Tclock>
+constexpr double CDeadlineQueue<Tkey, Tvalue, Tclock>::MAX_WAIT_SEC;
+
+
+}   // namespace time_pkg
+
+#endif // _DEADLINE_QUEUE_BY_KES_H_
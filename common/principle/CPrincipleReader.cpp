@@ -0,0 +1,836 @@
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+#include <json_headers.h>
+#include <rapidjson/reader.h>
+#include <rapidjson/memorystream.h>
+#include <rapidjson/encodedstream.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+#include <rapidjson/error/en.h>
+
+#include <logger.h>
+#include <CPrincipleReader.h>
+
+namespace principle {
+
+constexpr CPrincipleReader::Tsection CPrincipleReader::SECTION_NONE;
+constexpr CPrincipleReader::Tsection CPrincipleReader::SECTION_WHO;
+constexpr CPrincipleReader::Tsection CPrincipleReader::SECTION_WHEN;
+constexpr CPrincipleReader::Tsection CPrincipleReader::SECTION_WHERE;
+constexpr CPrincipleReader::Tsection CPrincipleReader::SECTION_WHAT;
+constexpr CPrincipleReader::Tsection CPrincipleReader::SECTION_HOW;
+constexpr CPrincipleReader::Tsection CPrincipleReader::SECTION_WHY;
+constexpr uint8_t CPrincipleReader::BINARY_MAGIC;
+constexpr uint8_t CPrincipleReader::BINARY_END;
+
+namespace {
+
+using Tsection = CPrincipleReader::Tsection;
+
+typedef enum E_FIELD {
+    E_FIELD_NONE = -1,
+    E_FIELD_VERSION = 0,
+    E_FIELD_WHO_APP,
+    E_FIELD_WHO_PVD,
+    E_FIELD_WHO_FUNC,
+    E_FIELD_WHEN_TYPE,
+    E_FIELD_WHEN_LATENCY,
+    E_FIELD_WHEN_WEEK,
+    E_FIELD_WHEN_PERIOD,
+    E_FIELD_WHEN_DATE,
+    E_FIELD_WHEN_TIME,
+    E_FIELD_WHERE_TYPE,
+    E_FIELD_WHERE_GPS_LONG,
+    E_FIELD_WHERE_GPS_LAT,
+    E_FIELD_WHERE_DB_TYPE,
+    E_FIELD_WHERE_DB_PATH,
+    E_FIELD_WHERE_DB_TABLE,
+    E_FIELD_WHAT_TYPE,
+    E_FIELD_WHAT_SEQ,
+    E_FIELD_HOW_TYPE,
+    E_FIELD_HOW_METHOD_PRE,
+    E_FIELD_HOW_COSTTIME,
+    E_FIELD_HOW_METHOD_POST,
+    E_FIELD_WHY_DESP,
+    E_FIELD_CNT
+} E_FIELD;
+
+struct CSectionKey {
+    const char* key;
+    Tsection section;
+    const char* sub_key;        // key of sub-object. (Ex: when.time, where.contents)
+};
+
+struct CFieldKey {
+    Tsection section;
+    bool in_sub;                // true: key of sub-object.
+    const char* key;
+    E_FIELD field;
+};
+
+const CSectionKey SECTION_KEYS[] = {
+    { "who",    CPrincipleReader::SECTION_WHO,      NULL },
+    { "when",   CPrincipleReader::SECTION_WHEN,     "time" },
+    { "where",  CPrincipleReader::SECTION_WHERE,    "contents" },
+    { "what",   CPrincipleReader::SECTION_WHAT,     "contents" },
+    { "how",    CPrincipleReader::SECTION_HOW,      "contents" },
+    { "why",    CPrincipleReader::SECTION_WHY,      NULL }
+};
+
+const CFieldKey FIELD_KEYS[] = {
+    { CPrincipleReader::SECTION_WHO,   false, "app",         E_FIELD_WHO_APP },
+    { CPrincipleReader::SECTION_WHO,   false, "pvd",         E_FIELD_WHO_PVD },
+    { CPrincipleReader::SECTION_WHO,   false, "func",        E_FIELD_WHO_FUNC },
+    { CPrincipleReader::SECTION_WHEN,  false, "type",        E_FIELD_WHEN_TYPE },
+    { CPrincipleReader::SECTION_WHEN,  true,  "latency",     E_FIELD_WHEN_LATENCY },
+    { CPrincipleReader::SECTION_WHEN,  true,  "week",        E_FIELD_WHEN_WEEK },
+    { CPrincipleReader::SECTION_WHEN,  true,  "period",      E_FIELD_WHEN_PERIOD },
+    { CPrincipleReader::SECTION_WHEN,  true,  "date",        E_FIELD_WHEN_DATE },
+    { CPrincipleReader::SECTION_WHEN,  true,  "time",        E_FIELD_WHEN_TIME },
+    { CPrincipleReader::SECTION_WHERE, false, "type",        E_FIELD_WHERE_TYPE },
+    { CPrincipleReader::SECTION_WHERE, true,  "long",        E_FIELD_WHERE_GPS_LONG },
+    { CPrincipleReader::SECTION_WHERE, true,  "lat",         E_FIELD_WHERE_GPS_LAT },
+    { CPrincipleReader::SECTION_WHERE, true,  "type",        E_FIELD_WHERE_DB_TYPE },
+    { CPrincipleReader::SECTION_WHERE, true,  "path",        E_FIELD_WHERE_DB_PATH },
+    { CPrincipleReader::SECTION_WHERE, true,  "table",       E_FIELD_WHERE_DB_TABLE },
+    { CPrincipleReader::SECTION_WHAT,  false, "type",        E_FIELD_WHAT_TYPE },
+    { CPrincipleReader::SECTION_WHAT,  true,  "seq",         E_FIELD_WHAT_SEQ },
+    { CPrincipleReader::SECTION_HOW,   false, "type",        E_FIELD_HOW_TYPE },
+    { CPrincipleReader::SECTION_HOW,   true,  "method-pre",  E_FIELD_HOW_METHOD_PRE },
+    { CPrincipleReader::SECTION_HOW,   true,  "costtime",    E_FIELD_HOW_COSTTIME },
+    { CPrincipleReader::SECTION_HOW,   true,  "method-post", E_FIELD_HOW_METHOD_POST },
+    { CPrincipleReader::SECTION_WHY,   false, "desp",        E_FIELD_WHY_DESP }
+};
+
+const char* const KEY_VERSION = "version";
+
+constexpr size_t BINARY_HEADER_SIZE = 3;        // MAGIC, bits of sections, bits of sub-objects
+constexpr size_t BINARY_FIELD_HEADER_SIZE = 3;  // field-id, length(2)
+constexpr size_t BINARY_VALUE_MAX = 0xFFFF;
+constexpr uint8_t BINARY_NUMBER_FLAG = 0x80;    // in field-id : value was json-number, not json-string.
+
+inline bool is_equal( const char* key, const char* str, size_t length ) {
+    return strlen(key) == length && memcmp(key, str, length) == 0;
+}
+
+/** Value of payload is string or number, so both of them are accepted. */
+double to_double( const std::string& value ) {
+    char* end = NULL;
+    double result = strtod( value.c_str(), &end );
+    if( value.empty() == true || *end != '\0' ) {
+        throw std::invalid_argument( "\"" + value + "\" is not double." );
+    }
+    return result;
+}
+
+uint32_t to_uint32( const std::string& value ) {
+    char* end = NULL;
+    unsigned long result = strtoul( value.c_str(), &end, 10 );
+    if( value.empty() == true || *end != '\0' || value[0] == '-' || result > UINT32_MAX ) {
+        throw std::invalid_argument( "\"" + value + "\" is not uint32_t." );
+    }
+    return static_cast<uint32_t>(result);
+}
+
+/** Number is printed like rapidjson::Writer, so binary-body is same with the one converted from json-text. */
+std::string from_double( double value ) {
+    char buffer[32];
+    if( rapidjson::internal::Double(value).IsNanOrInf() == true ) {
+        throw std::invalid_argument("NaN/Inf is not json-number.");
+    }
+    return std::string( buffer, rapidjson::internal::dtoa(value, buffer) );
+}
+
+std::string from_uint32( uint32_t value ) {
+    char buffer[16];
+    return std::string( buffer, rapidjson::internal::u32toa(value, buffer) );
+}
+
+}   // namespace
+
+
+/*********************************
+ * SAX-Handler : It keeps values of principle-6 keys in slots.
+ *  - depth 1 : root-object, depth 2 : section-object, depth 3 : sub-object of section.
+ */
+class CPrincipleReader::CHandler : public rapidjson::BaseReaderHandler<rapidjson::UTF8<>, CPrincipleReader::CHandler> {
+public:
+    CHandler(void)
+    : _m_depth_(0), _m_section_(SECTION_NONE), _m_in_sub_(false),
+      _m_found_(SECTION_NONE), _m_sub_found_(SECTION_NONE), _m_invalid_(SECTION_NONE), _m_present_(0), _m_number_(0), _m_unknown_(false) {
+        reset_key();
+    }
+
+    /** SAX-events */
+    bool Default(void) {
+        // bool or null value.
+        if( _m_field_ != E_FIELD_NONE ) {
+            _m_invalid_ |= get_field_section(_m_field_);
+        }
+        check_scalar();
+        reset_key();
+        return true;
+    }
+
+    bool String( const char* str, rapidjson::SizeType length, bool /*copy*/ ) {
+        if( _m_field_ != E_FIELD_NONE ) {
+            _mv_values_[_m_field_].assign( str, length );
+            _m_present_ |= (1u << _m_field_);
+            _m_number_ &= ~(1u << _m_field_);
+        }
+        check_scalar();
+        reset_key();
+        return true;
+    }
+
+    bool RawNumber( const char* str, rapidjson::SizeType length, bool copy ) {
+        E_FIELD field = _m_field_;
+        String( str, length, copy );
+        if( field != E_FIELD_NONE ) {
+            _m_number_ |= (1u << field);
+        }
+        return true;
+    }
+
+    bool Key( const char* str, rapidjson::SizeType length, bool /*copy*/ ) {
+        reset_key();
+
+        if( _m_depth_ == 1 ) {
+            if( is_equal(KEY_VERSION, str, length) == true ) {
+                _m_field_ = E_FIELD_VERSION;
+                return true;
+            }
+
+            for( auto& sec : SECTION_KEYS ) {
+                if( is_equal(sec.key, str, length) == true ) {
+                    _m_key_section_ = sec.section;
+                    break;
+                }
+            }
+            _m_unknown_ |= (_m_key_section_ == SECTION_NONE);
+        }
+        else if( (_m_depth_ == 2 || (_m_depth_ == 3 && _m_in_sub_ == true)) && _m_section_ != SECTION_NONE ) {
+            bool in_sub = (_m_depth_ == 3);
+
+            if( in_sub == false ) {
+                const char* sub_key = get_sub_key( _m_section_ );
+                _m_key_sub_ = (sub_key != NULL && is_equal(sub_key, str, length) == true);
+            }
+
+            for( auto& field : FIELD_KEYS ) {
+                if( field.section == _m_section_ && field.in_sub == in_sub && is_equal(field.key, str, length) == true ) {
+                    _m_field_ = field.field;
+                    break;
+                }
+            }
+            _m_unknown_ |= (_m_field_ == E_FIELD_NONE && _m_key_sub_ == false);
+        }
+        return true;
+    }
+
+    bool StartObject(void) {
+        enter( true );
+        return true;
+    }
+
+    bool EndObject( rapidjson::SizeType /*member_count*/ ) {
+        leave();
+        return true;
+    }
+
+    bool StartArray(void) {
+        enter( false );
+        return true;
+    }
+
+    bool EndArray( rapidjson::SizeType /*element_count*/ ) {
+        leave();
+        return true;
+    }
+
+    /** Getter for building of sections. */
+    bool has( E_FIELD field ) const {
+        return (_m_present_ & (1u << field)) != 0;
+    }
+
+    const std::string& get( E_FIELD field ) const {
+        if( has(field) == false ) {
+            throw std::out_of_range( "Field(" + std::to_string(field) + ") is not exist." );
+        }
+        return _mv_values_[field];
+    }
+
+    bool is_found( Tsection section ) const {
+        return (_m_found_ & section) != 0;
+    }
+
+    bool is_sub_found( Tsection section ) const {
+        return (_m_sub_found_ & section) != 0;
+    }
+
+    bool is_invalid( Tsection section ) const {
+        return (_m_invalid_ & section) != 0;
+    }
+
+    bool is_number( E_FIELD field ) const {
+        return (_m_number_ & (1u << field)) != 0;
+    }
+
+    /** Setter for building slots directly from sections. (instead of SAX-events) */
+    void set( E_FIELD field, const std::string& value, bool is_number=false ) {
+        _mv_values_[field] = value;
+        _m_present_ |= (1u << field);
+        if( is_number == true ) {
+            _m_number_ |= (1u << field);
+        }
+        else {
+            _m_number_ &= ~(1u << field);
+        }
+    }
+
+    void set_found( Tsection section, bool has_sub ) {
+        _m_found_ |= section;
+        if( has_sub == true ) {
+            _m_sub_found_ |= section;
+        }
+    }
+
+    /** return false, if payload can not be kept in binary-body without loss. (invalid section, unknown key, no version) */
+    bool store_binary( std::string& binary ) const {
+        if( _m_invalid_ != SECTION_NONE || _m_unknown_ == true || has(E_FIELD_VERSION) == false ) {
+            return false;
+        }
+
+        binary.clear();
+        binary.push_back( static_cast<char>(BINARY_MAGIC) );
+        binary.push_back( static_cast<char>(_m_found_) );
+        binary.push_back( static_cast<char>(_m_sub_found_) );
+
+        for( int field=0; field < E_FIELD_CNT; field++ ) {
+            if( has(static_cast<E_FIELD>(field)) == false ) {
+                continue;
+            }
+
+            const std::string& value = _mv_values_[field];
+            if( value.length() > BINARY_VALUE_MAX ) {
+                return false;
+            }
+            uint8_t field_id = static_cast<uint8_t>(field);
+            if( is_number(static_cast<E_FIELD>(field)) == true ) {
+                field_id |= BINARY_NUMBER_FLAG;
+            }
+            binary.push_back( static_cast<char>(field_id) );
+            binary.push_back( static_cast<char>(value.length() & 0xFF) );
+            binary.push_back( static_cast<char>((value.length() >> 8) & 0xFF) );
+            binary.append( value );
+        }
+
+        binary.push_back( static_cast<char>(BINARY_END) );
+        return true;
+    }
+
+    /** throw std::invalid_argument, if binary-body is broken. */
+    void load_binary( const char* binary, size_t length ) {
+        const uint8_t* data = reinterpret_cast<const uint8_t*>(binary);
+        size_t pos = BINARY_HEADER_SIZE;
+
+        if( length < BINARY_HEADER_SIZE + 1 || data[0] != BINARY_MAGIC ) {
+            throw std::invalid_argument("Binary-body has not header.");
+        }
+        _m_found_ = data[1];
+        _m_sub_found_ = data[2];
+
+        while( pos < length && data[pos] != BINARY_END ) {
+            uint8_t field_id = data[pos] & ~BINARY_NUMBER_FLAG;
+            if( pos + BINARY_FIELD_HEADER_SIZE > length || field_id >= E_FIELD_CNT ) {
+                throw std::invalid_argument( "Binary-body has invalid field at " + std::to_string(pos) );
+            }
+
+            E_FIELD field = static_cast<E_FIELD>(field_id);
+            size_t value_len = data[pos+1] | (data[pos+2] << 8);
+            pos += BINARY_FIELD_HEADER_SIZE;
+            if( pos + value_len > length ) {
+                throw std::invalid_argument( "Binary-body is truncated at " + std::to_string(pos) );
+            }
+
+            _mv_values_[field].assign( binary + pos, value_len );
+            _m_present_ |= (1u << field);
+            if( (data[pos - BINARY_FIELD_HEADER_SIZE] & BINARY_NUMBER_FLAG) != 0 ) {
+                to_double( _mv_values_[field] );     // it's written as raw-number by write_json().
+                _m_number_ |= (1u << field);
+            }
+            pos += value_len;
+        }
+
+        if( pos + 1 != length ) {
+            throw std::invalid_argument("Binary-body is not terminated by END.");
+        }
+    }
+
+    template <typename Twriter>
+    void write_json( Twriter& writer ) const {
+        writer.StartObject();
+        if( has(E_FIELD_VERSION) == true ) {
+            writer.Key( KEY_VERSION );
+            write_value( writer, E_FIELD_VERSION );
+        }
+
+        for( auto& sec : SECTION_KEYS ) {
+            if( is_found(sec.section) == false ) {
+                continue;
+            }
+
+            writer.Key( sec.key );
+            writer.StartObject();
+            write_fields( writer, sec.section, false );
+            if( sec.sub_key != NULL && is_sub_found(sec.section) == true ) {
+                writer.Key( sec.sub_key );
+                writer.StartObject();
+                write_fields( writer, sec.section, true );
+                writer.EndObject();
+            }
+            writer.EndObject();
+        }
+        writer.EndObject();
+    }
+
+private:
+    static Tsection get_field_section( E_FIELD field ) {
+        for( auto& key : FIELD_KEYS ) {
+            if( key.field == field ) {
+                return key.section;
+            }
+        }
+        return SECTION_NONE;
+    }
+
+    static const char* get_sub_key( Tsection section ) {
+        for( auto& sec : SECTION_KEYS ) {
+            if( sec.section == section ) {
+                return sec.sub_key;
+            }
+        }
+        return NULL;
+    }
+
+    template <typename Twriter>
+    void write_fields( Twriter& writer, Tsection section, bool in_sub ) const {
+        for( auto& key : FIELD_KEYS ) {
+            if( key.section == section && key.in_sub == in_sub && has(key.field) == true ) {
+                writer.Key( key.key );
+                write_value( writer, key.field );
+            }
+        }
+    }
+
+    /** Number is written as it was received, so DOM-path can read it by number-type. */
+    template <typename Twriter>
+    void write_value( Twriter& writer, E_FIELD field ) const {
+        const std::string& value = _mv_values_[field];
+        if( is_number(field) == true ) {
+            writer.RawValue( value.c_str(), value.length(), rapidjson::kNumberType );
+        }
+        else {
+            writer.String( value.c_str(), value.length() );
+        }
+    }
+
+    /** Section & sub-object must be object, not scalar value. */
+    void check_scalar(void) {
+        _m_invalid_ |= _m_key_section_;
+        if( _m_key_sub_ == true ) {
+            _m_invalid_ |= _m_section_;
+        }
+    }
+
+    void reset_key(void) {
+        _m_field_ = E_FIELD_NONE;
+        _m_key_section_ = SECTION_NONE;
+        _m_key_sub_ = false;
+    }
+
+    void enter( bool is_object ) {
+        if( _m_depth_ == 1 && _m_key_section_ != SECTION_NONE ) {
+            if( is_object == true ) {
+                _m_section_ = _m_key_section_;
+                _m_found_ |= _m_section_;
+            }
+            else {
+                _m_invalid_ |= _m_key_section_;
+            }
+        }
+        else if( _m_depth_ == 2 && _m_section_ != SECTION_NONE ) {
+            if( is_object == true && _m_key_sub_ == true ) {
+                _m_in_sub_ = true;
+                _m_sub_found_ |= _m_section_;
+            }
+            else if( _m_key_sub_ == true || _m_field_ != E_FIELD_NONE ) {
+                _m_invalid_ |= _m_section_;
+            }
+        }
+        else if( _m_depth_ == 3 && _m_in_sub_ == true ) {
+            // nested contents (Ex: 'db' type of What/How) is decoded by DOM-path.
+            _m_invalid_ |= _m_section_;
+        }
+
+        _m_depth_++;
+        reset_key();
+    }
+
+    void leave(void) {
+        _m_depth_--;
+        if( _m_depth_ == 1 ) {
+            _m_section_ = SECTION_NONE;
+        }
+        if( _m_depth_ <= 2 ) {
+            _m_in_sub_ = false;
+        }
+        reset_key();
+    }
+
+private:
+    int _m_depth_;
+
+    Tsection _m_section_;       // section that is being scanned.
+
+    bool _m_in_sub_;
+
+    E_FIELD _m_field_;          // field of latest key.
+
+    Tsection _m_key_section_;   // section of latest key. (depth 1)
+
+    bool _m_key_sub_;           // latest key is key of sub-object. (depth 2)
+
+    Tsection _m_found_;
+
+    Tsection _m_sub_found_;
+
+    Tsection _m_invalid_;
+
+    uint32_t _m_present_;
+
+    uint32_t _m_number_;
+
+    bool _m_unknown_;           // payload has key that is not principle-6.
+
+    std::string _mv_values_[E_FIELD_CNT];
+
+};
+
+
+/*********************************
+ * Definition of Public Function.
+ */
+CPrincipleReader::CPrincipleReader( double def_time )
+: _m_def_time_(def_time) {
+    clear();
+}
+
+CPrincipleReader::~CPrincipleReader(void) {
+    clear();
+}
+
+void CPrincipleReader::parse( const char* payload, size_t length ) {
+    CHandler handler;
+    clear();
+
+    if( is_binary(payload, length) == true ) {
+        try {
+            handler.load_binary( payload, length );
+        }
+        catch( const std::invalid_argument& e ) {
+            throw std::runtime_error( std::string("Invalid Binary-payload. ") + e.what() );
+        }
+    }
+    else {
+        scan( payload, length, handler );
+    }
+
+    if( handler.has(E_FIELD_VERSION) == true ) {
+        _m_version_ = handler.get(E_FIELD_VERSION);
+    }
+
+    build( handler, SECTION_WHO, _m_who_, [this](const CHandler& h) { return build_who(h); } );
+    build( handler, SECTION_WHEN, _m_when_, [this](const CHandler& h) { return build_when(h); } );
+    build( handler, SECTION_WHERE, _m_where_, [this](const CHandler& h) { return build_where(h); } );
+    build( handler, SECTION_WHAT, _m_what_, [this](const CHandler& h) { return build_what(h); } );
+    build( handler, SECTION_HOW, _m_how_, [this](const CHandler& h) { return build_how(h); } );
+    build( handler, SECTION_WHY, _m_why_, [this](const CHandler& h) { return build_why(h); } );
+}
+
+
+bool CPrincipleReader::is_binary( const char* payload, size_t length ) {
+    return payload != NULL && length > 0 && static_cast<uint8_t>(payload[0]) == BINARY_MAGIC;
+}
+
+bool CPrincipleReader::to_binary( const char* payload, size_t length, std::string& binary ) {
+    try {
+        CHandler handler;
+
+        if( is_binary(payload, length) == true ) {
+            binary.assign( payload, length );
+            return true;
+        }
+
+        scan( payload, length, handler );
+        return handler.store_binary( binary );
+    }
+    catch( const std::exception& e ) {
+        LOGW("%s", e.what());
+    }
+
+    return false;
+}
+
+bool CPrincipleReader::to_binary( const std::string& version, CWho& who, CWhen& when, CWhere& where,
+                                  CWhat& what, CHow& how, const std::string& why, std::string& binary ) {
+    try {
+        CHandler handler;
+        std::string type;
+
+        // Slots are filled in same way of ICommand::apply_xxx(). (json-body & binary-body have same contents.)
+        handler.set( E_FIELD_VERSION, version );
+
+        handler.set_found( SECTION_WHO, false );
+        handler.set( E_FIELD_WHO_APP, who.get_app() );
+        handler.set( E_FIELD_WHO_PVD, who.get_pvd() );
+        if( who.get_func() != CWho::STR_NULL ) {
+            handler.set( E_FIELD_WHO_FUNC, who.get_func() );
+        }
+
+        handler.set_found( SECTION_WHEN, true );
+        handler.set( E_FIELD_WHEN_TYPE, when.get_type() );
+        if( when.get_latency() != CWhen::LATENCY_NULL ) {
+            handler.set( E_FIELD_WHEN_LATENCY, from_double( when.get_latency() ), true );
+        }
+        else {
+            if( when.get_time() != CWhen::TIME_NULL_STR ) {
+                handler.set( E_FIELD_WHEN_DATE, when.get_date() );
+                handler.set( E_FIELD_WHEN_TIME, when.get_time() );
+            }
+
+            if( when.get_week() != CWhen::WEEK_NULL_STR ) {
+                handler.set( E_FIELD_WHEN_WEEK, when.get_week() );
+            }
+
+            if( when.get_period() != CWhen::PERIOD_NULL ) {
+                handler.set( E_FIELD_WHEN_PERIOD, from_uint32( when.get_period() ), true );
+            }
+        }
+
+        type = where.get_type();
+        handler.set_found( SECTION_WHERE, true );
+        handler.set( E_FIELD_WHERE_TYPE, type );
+        if( type == CWhere::TYPE_GPS ) {
+            handler.set( E_FIELD_WHERE_GPS_LONG, from_double( where.gps_longitude() ), true );
+            handler.set( E_FIELD_WHERE_GPS_LAT, from_double( where.gps_latitude() ), true );
+        }
+        else if( type == CWhere::TYPE_DB ) {
+            handler.set( E_FIELD_WHERE_DB_TYPE, type_convert( where.db_type() ) );
+            handler.set( E_FIELD_WHERE_DB_PATH, where.db_path() );
+            handler.set( E_FIELD_WHERE_DB_TABLE, where.db_table() );
+        }
+        else if( type != CWhere::TYPE_UNKNOWN && type != CWhere::TYPE_NOTCARE ) {
+            return false;
+        }
+
+        // 'db' contents of What/How is not kept in binary-body.
+        if( what.get_type() != CWhat::TYPE_VALVE || how.get_type() != CHow::TYPE_VALVE ) {
+            return false;
+        }
+
+        handler.set_found( SECTION_WHAT, true );
+        handler.set( E_FIELD_WHAT_TYPE, what.get_type() );
+        handler.set( E_FIELD_WHAT_SEQ, from_uint32( what.valve_which() ), true );
+
+        handler.set_found( SECTION_HOW, true );
+        handler.set( E_FIELD_HOW_TYPE, how.get_type() );
+        handler.set( E_FIELD_HOW_METHOD_PRE, type_convert( how.valve_method_pre() ) );
+        handler.set( E_FIELD_HOW_COSTTIME, from_double( how.valve_costtime() ), true );
+        handler.set( E_FIELD_HOW_METHOD_POST, type_convert( how.valve_method_post() ) );
+
+        handler.set_found( SECTION_WHY, false );
+        handler.set( E_FIELD_WHY_DESP, why );
+
+        return handler.store_binary( binary );
+    }
+    catch( const std::exception& e ) {
+        LOGW("%s", e.what());
+    }
+
+    return false;
+}
+
+std::string CPrincipleReader::to_json( const char* binary, size_t length ) {
+    CHandler handler;
+    rapidjson::StringBuffer buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer( buffer );
+
+    handler.load_binary( binary, length );
+    handler.write_json( writer );
+    return std::string( buffer.GetString(), buffer.GetSize() );
+}
+
+bool CPrincipleReader::is_valid_binary( const char* binary, size_t length, std::string* reason ) {
+    try {
+        CHandler handler;
+        handler.load_binary( binary, length );
+        return true;
+    }
+    catch( const std::exception& e ) {
+        if( reason != NULL ) {
+            *reason = e.what();
+        }
+    }
+
+    return false;
+}
+
+
+/*********************************
+ * Definition of Private Function.
+ */
+void CPrincipleReader::scan( const char* payload, size_t length, CHandler& handler ) {
+    if( payload == NULL ) {
+        throw std::runtime_error("Invalid Json-payload. Please check it.");
+    }
+
+    rapidjson::Reader reader;
+    rapidjson::MemoryStream stream( payload, length );
+    rapidjson::EncodedInputStream<rapidjson::UTF8<>, rapidjson::MemoryStream> is( stream );
+
+    auto result = reader.Parse<rapidjson::kParseCommentsFlag | rapidjson::kParseNumbersAsStringsFlag>( is, handler );
+    if( result.IsError() == true ) {
+        std::string err = "Invalid Json-payload. Please check it. (" + std::string(rapidjson::GetParseError_En(result.Code()))
+                        + " at " + std::to_string(result.Offset()) + ")";
+        throw std::runtime_error(err);
+    }
+}
+
+void CPrincipleReader::clear(void) {
+    _m_version_.clear();
+    _m_sections_ = SECTION_NONE;
+    _m_who_.reset();
+    _m_when_.reset();
+    _m_where_.reset();
+    _m_what_.reset();
+    _m_how_.reset();
+    _m_why_.reset();
+}
+
+template <typename T, typename Fbuild>
+void CPrincipleReader::build( const CHandler& handler, Tsection bit, std::shared_ptr<T>& section, Fbuild builder ) {
+    if( handler.is_found(bit) == false || handler.is_invalid(bit) == true ) {
+        return;
+    }
+
+    try {
+        section = builder( handler );
+        if( section.get() != NULL ) {
+            _m_sections_ |= bit;
+        }
+    }
+    catch( const std::exception& e ) {
+        // DOM-path will report the error, when this section is accessed.
+        LOGD("section(0x%02X) is not built: %s", bit, e.what());
+        section.reset();
+    }
+}
+
+std::shared_ptr<CWho> CPrincipleReader::build_who( const CHandler& handler ) {
+    std::string func = CWho::STR_NULL;
+
+    if( handler.has(E_FIELD_WHO_FUNC) == true ) {
+        func = handler.get(E_FIELD_WHO_FUNC);
+    }
+    return std::make_shared<CWho>( handler.get(E_FIELD_WHO_APP), handler.get(E_FIELD_WHO_PVD), func );
+}
+
+std::shared_ptr<CWhen> CPrincipleReader::build_when( const CHandler& handler ) {
+    double latency = CWhen::LATENCY_NULL;
+    std::string week = CWhen::WEEK_NULL_STR;
+    uint32_t period = CWhen::PERIOD_NULL;
+    std::string date = CWhen::DATE_NULL_STR;
+    std::string time = CWhen::TIME_NULL_STR;
+
+    if( handler.is_sub_found(SECTION_WHEN) == false ) {
+        return NULL;
+    }
+
+    if( handler.has(E_FIELD_WHEN_LATENCY) == true )
+        latency = to_double( handler.get(E_FIELD_WHEN_LATENCY) );
+
+    if( handler.has(E_FIELD_WHEN_WEEK) == true )
+        week = handler.get(E_FIELD_WHEN_WEEK);
+
+    if( handler.has(E_FIELD_WHEN_PERIOD) == true )
+        period = to_uint32( handler.get(E_FIELD_WHEN_PERIOD) );
+
+    if( handler.has(E_FIELD_WHEN_DATE) == true )
+        date = handler.get(E_FIELD_WHEN_DATE);
+
+    if( handler.has(E_FIELD_WHEN_TIME) == true )
+        time = handler.get(E_FIELD_WHEN_TIME);
+
+    return std::make_shared<CWhen>( handler.get(E_FIELD_WHEN_TYPE), date, time, week, period, latency, _m_def_time_ );
+}
+
+std::shared_ptr<CWhere> CPrincipleReader::build_where( const CHandler& handler ) {
+    if( handler.is_sub_found(SECTION_WHERE) == false ) {
+        return NULL;
+    }
+
+    const std::string& type = handler.get(E_FIELD_WHERE_TYPE);
+    if( type == CWhere::TYPE_GPS ) {
+        return std::make_shared<CWhere>( type, to_double( handler.get(E_FIELD_WHERE_GPS_LONG) ),
+                                               to_double( handler.get(E_FIELD_WHERE_GPS_LAT) ) );
+    }
+    else if( type == CWhere::TYPE_DB ) {
+        return std::make_shared<CWhere>( type, type_convert<Tdb_type>( handler.get(E_FIELD_WHERE_DB_TYPE) ),
+                                               handler.get(E_FIELD_WHERE_DB_PATH),
+                                               handler.get(E_FIELD_WHERE_DB_TABLE) );
+    }
+    else if( type == CWhere::TYPE_UNKNOWN || type == CWhere::TYPE_NOTCARE ) {
+        return std::make_shared<CWhere>( type );
+    }
+
+    return NULL;
+}
+
+std::shared_ptr<CWhat> CPrincipleReader::build_what( const CHandler& handler ) {
+    if( handler.is_sub_found(SECTION_WHAT) == false ) {
+        return NULL;
+    }
+
+    const std::string& type = handler.get(E_FIELD_WHAT_TYPE);
+    if( type == CWhat::TYPE_VALVE ) {
+        return std::make_shared<CWhat>( type, static_cast<int>( to_uint32( handler.get(E_FIELD_WHAT_SEQ) ) ) );
+    }
+
+    return NULL;
+}
+
+std::shared_ptr<CHow> CPrincipleReader::build_how( const CHandler& handler ) {
+    if( handler.is_sub_found(SECTION_HOW) == false ) {
+        return NULL;
+    }
+
+    const std::string& type = handler.get(E_FIELD_HOW_TYPE);
+    if( type == CHow::TYPE_VALVE ) {
+        return std::make_shared<CHow>( type, type_convert<Tvalve_method>( handler.get(E_FIELD_HOW_METHOD_PRE) ),
+                                             to_double( handler.get(E_FIELD_HOW_COSTTIME) ),
+                                             type_convert<Tvalve_method>( handler.get(E_FIELD_HOW_METHOD_POST) ) );
+    }
+
+    return NULL;
+}
+
+std::shared_ptr<std::string> CPrincipleReader::build_why( const CHandler& handler ) {
+    return std::make_shared<std::string>( handler.get(E_FIELD_WHY_DESP) );
+}
+
+
+}   // principle
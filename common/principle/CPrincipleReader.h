@@ -0,0 +1,137 @@
+#ifndef _PRINCIPLE_6_READER_H_
+#define _PRINCIPLE_6_READER_H_
+
+#include <string>
+#include <memory>
+#include <cstdint>
+
+#include <json_headers.h>
+#include <Principle6.h>
+
+namespace principle {
+
+
+/***
+ * Streaming parser of principle-6 payload. (Based on rapidjson::Reader, so DOM is not built.)
+ *  - Payload is scanned once, and values of known keys are kept in fixed slots.
+ *    After scanning, CWho/CWhen/CWhere/CWhat/CHow/Why are built directly from the slots.
+ *  - Section that can not be built by this reader (Ex: 'db' contents of What/How, missing key, wrong value-type)
+ *    is not marked in get_sections(), so caller has to decode it with DOM-path for it.
+ *  - Slots can be written as compact binary-body instead of json-text. (TLV: It does not have keys, spaces and comments.)
+ *      [MAGIC][bits of sections][bits of sub-objects] { [field-id:1][length:2 (LE)][value:length] }... [END]
+ *    parse() detects binary-body by first byte. (MAGIC is not valid for first byte of json-text.)
+ ***/
+class CPrincipleReader {
+public:
+    using Tsection = uint8_t;
+
+    /** Bits of principle-6 sections. */
+    static constexpr Tsection SECTION_NONE = 0x00;
+    static constexpr Tsection SECTION_WHO = 0x01;
+    static constexpr Tsection SECTION_WHEN = 0x02;
+    static constexpr Tsection SECTION_WHERE = 0x04;
+    static constexpr Tsection SECTION_WHAT = 0x08;
+    static constexpr Tsection SECTION_HOW = 0x10;
+    static constexpr Tsection SECTION_WHY = 0x20;
+
+    static constexpr uint8_t BINARY_MAGIC = 0xB1;
+    static constexpr uint8_t BINARY_END = 0xFF;
+
+private:
+    class CHandler;
+
+public:
+    /** def_time : default start-time of 'when' section. */
+    explicit CPrincipleReader( double def_time=CWhen::START_TIME_NULL );
+
+    ~CPrincipleReader(void);
+
+    /** throw std::runtime_error, if payload is not json-format or binary-body. */
+    void parse( const char* payload, size_t length );
+
+    static bool is_binary( const char* payload, size_t length );
+
+    /** Convert json-payload to binary-body. (return false, if payload has section that binary-body can not keep.) */
+    static bool to_binary( const char* payload, size_t length, std::string& binary );
+
+    /** Build binary-body directly from sections without json-text. (return false, if section can not be kept. Ex: 'db' of What/How) */
+    static bool to_binary( const std::string& version, CWho& who, CWhen& when, CWhere& where,
+                           CWhat& what, CHow& how, const std::string& why, std::string& binary );
+
+    /** Convert binary-body to compact json-text. (throw std::invalid_argument, if binary-body is broken.) */
+    static std::string to_json( const char* binary, size_t length );
+
+    /** Check structure of binary-body. (reason: why it's broken.) */
+    static bool is_valid_binary( const char* binary, size_t length, std::string* reason=NULL );
+
+    /** Empty, if "version" is not exist in payload. */
+    const std::string& get_version(void) const { return _m_version_; }
+
+    /** Bits of sections that are built by parse(). */
+    Tsection get_sections(void) const { return _m_sections_; }
+
+    std::shared_ptr<CWho> get_who(void) const { return _m_who_; }
+
+    std::shared_ptr<CWhen> get_when(void) const { return _m_when_; }
+
+    std::shared_ptr<CWhere> get_where(void) const { return _m_where_; }
+
+    std::shared_ptr<CWhat> get_what(void) const { return _m_what_; }
+
+    std::shared_ptr<CHow> get_how(void) const { return _m_how_; }
+
+    std::shared_ptr<std::string> get_why(void) const { return _m_why_; }
+
+private:
+    CPrincipleReader(const CPrincipleReader&) = delete;             // copy constructor
+    CPrincipleReader& operator=(const CPrincipleReader&) = delete;  // copy operator
+    CPrincipleReader(CPrincipleReader&&) = delete;                  // move constructor
+    CPrincipleReader& operator=(CPrincipleReader&&) = delete;       // move operator
+
+    void clear(void);
+
+    /** throw std::runtime_error, if payload is not json-format. */
+    static void scan( const char* payload, size_t length, CHandler& handler );
+
+    /** Build section from slots of handler. (Section is skipped, if building is failed.) */
+    template <typename T, typename Fbuild>
+    void build( const CHandler& handler, Tsection bit, std::shared_ptr<T>& section, Fbuild builder );
+
+    std::shared_ptr<CWho> build_who( const CHandler& handler );
+
+    std::shared_ptr<CWhen> build_when( const CHandler& handler );
+
+    std::shared_ptr<CWhere> build_where( const CHandler& handler );
+
+    std::shared_ptr<CWhat> build_what( const CHandler& handler );
+
+    std::shared_ptr<CHow> build_how( const CHandler& handler );
+
+    std::shared_ptr<std::string> build_why( const CHandler& handler );
+
+private:
+    double _m_def_time_;
+
+    std::string _m_version_;
+
+    Tsection _m_sections_;
+
+    std::shared_ptr<CWho> _m_who_;
+
+    std::shared_ptr<CWhen> _m_when_;
+
+    std::shared_ptr<CWhere> _m_where_;
+
+    std::shared_ptr<CWhat> _m_what_;
+
+    std::shared_ptr<CHow> _m_how_;
+
+    std::shared_ptr<std::string> _m_why_;
+
+};
+
+
+}   // principle
+
+
+#endif // _PRINCIPLE_6_READER_H_
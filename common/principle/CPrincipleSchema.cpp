@@ -0,0 +1,189 @@
+#include <stdexcept>
+
+#include <json_headers.h>
+#include <rapidjson/reader.h>
+#include <rapidjson/schema.h>
+#include <rapidjson/memorystream.h>
+#include <rapidjson/encodedstream.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/error/en.h>
+
+#include <logger.h>
+#include <CPrincipleSchema.h>
+
+namespace principle {
+
+namespace {
+
+/**
+ * Numeric value is written as string (Ex: "40.0") or number.
+ * Digits of string are checked at conversion, because "pattern" keyword is more expensive than whole validation.
+ */
+const char* const SCHEMA = R"JSON(
+{
+    "type": "object",
+    "required": [ "version", "who", "when", "where", "what", "how" ],
+    "definitions": {
+        "number": { "type": [ "number", "string" ] },
+        "uint": { "type": [ "integer", "string" ], "minimum": 0 },
+        "valve_method": { "enum": [ "open", "close", "none" ] }
+    },
+    "properties": {
+        "version": { "type": "string" },
+        "who": {
+            "type": "object",
+            "required": [ "app", "pvd" ],
+            "properties": {
+                "app": { "type": "string" },
+                "pvd": { "type": "string" },
+                "func": { "type": "string" }
+            }
+        },
+        "when": {
+            "type": "object",
+            "required": [ "type", "time" ],
+            "properties": {
+                "type": { "enum": [ "one-time", "routine.week", "routine.day", "specific" ] },
+                "time": {
+                    "type": "object",
+                    "properties": {
+                        "latency": { "$ref": "#/definitions/number" },
+                        "week": { "enum": [ "mon", "tues", "wednes", "thurs", "fri", "satur", "sun", "none" ] },
+                        "period": { "$ref": "#/definitions/uint" },
+                        "date": { "type": "string" },
+                        "time": { "type": "string" }
+                    }
+                }
+            }
+        },
+        "where": {
+            "type": "object",
+            "required": [ "type" ],
+            "properties": {
+                "type": { "enum": [ "center.gps", "db", "unknown", "dont.care" ] },
+                "contents": {
+                    "type": "object",
+                    "properties": {
+                        "long": { "$ref": "#/definitions/number" },
+                        "lat": { "$ref": "#/definitions/number" },
+                        "type": { "enum": [ "SQL", "NOSQL" ] },
+                        "path": { "type": "string" },
+                        "table": { "type": "string" }
+                    }
+                }
+            }
+        },
+        "what": {
+            "type": "object",
+            "required": [ "type", "contents" ],
+            "properties": {
+                "type": { "enum": [ "valve.swc", "db" ] },
+                "contents": {
+                    "type": "object",
+                    "properties": {
+                        "seq": { "$ref": "#/definitions/uint" },
+                        "type": { "enum": [ "records", "elements", "none" ] },
+                        "target": { "type": "object" }
+                    }
+                }
+            }
+        },
+        "how": {
+            "type": "object",
+            "required": [ "type", "contents" ],
+            "properties": {
+                "type": { "enum": [ "valve.swc", "db" ] },
+                "contents": {
+                    "type": "object",
+                    "properties": {
+                        "method-pre": { "$ref": "#/definitions/valve_method" },
+                        "costtime": { "$ref": "#/definitions/number" },
+                        "method-post": { "$ref": "#/definitions/valve_method" },
+                        "method": { "enum": [ "select", "insert", "update", "delete" ] },
+                        "condition": { "type": "object" }
+                    }
+                }
+            }
+        },
+        "why": {
+            "type": "object",
+            "properties": {
+                "desp": { "type": "string" },
+                "objective": { "type": "array" },
+                "dependency": { "type": "array" }
+            }
+        }
+    }
+}
+)JSON";
+
+/** Compiled schema. (C++11 guarantees thread-safe initialization of static local variable.) */
+const rapidjson::SchemaDocument& get_schema( void ) {
+    static const rapidjson::SchemaDocument schema = []() {
+        json_mng::JsonManipulator doc;
+        doc.Parse( SCHEMA );
+        if( doc.HasParseError() == true ) {
+            std::string err = std::string("Invalid principle-6 schema: ") + rapidjson::GetParseError_En(doc.GetParseError());
+            throw std::logic_error(err);
+        }
+        return rapidjson::SchemaDocument( doc );
+    }();
+
+    return schema;
+}
+
+}   // namespace
+
+
+/*********************************
+ * Definition of Public Function.
+ */
+bool CPrincipleSchema::validate( const char* payload, size_t length, std::string* reason ) {
+    try {
+        if( payload == NULL ) {
+            throw std::invalid_argument("Payload is NULL.");
+        }
+
+        // ignore trailing NULL-characters of received bytes.
+        while( length > 0 && payload[length-1] == '\0' ) {
+            length--;
+        }
+
+        // validator is re-used per thread, because its creation costs more than validation.
+        static thread_local rapidjson::SchemaValidator validator( get_schema() );
+        validator.Reset();
+
+        rapidjson::Reader reader;
+        rapidjson::MemoryStream stream( payload, length );
+        rapidjson::EncodedInputStream<rapidjson::UTF8<>, rapidjson::MemoryStream> is( stream );
+
+        auto result = reader.Parse<rapidjson::kParseCommentsFlag>( is, validator );
+        if( validator.IsValid() == false ) {
+            if( reason != NULL ) {
+                rapidjson::StringBuffer pointer;
+                validator.GetInvalidDocumentPointer().StringifyUriFragment( pointer );
+                *reason = std::string("'") + validator.GetInvalidSchemaKeyword() + "' is violated at " + pointer.GetString();
+            }
+            return false;
+        }
+
+        if( result.IsError() == true ) {
+            if( reason != NULL ) {
+                *reason = std::string(rapidjson::GetParseError_En(result.Code())) + " at " + std::to_string(result.Offset());
+            }
+            return false;
+        }
+
+        return true;
+    }
+    catch( const std::exception& e ) {
+        if( reason != NULL ) {
+            *reason = e.what();
+        }
+    }
+
+    return false;
+}
+
+
+}   // principle
@@ -0,0 +1,28 @@
+#ifndef _PRINCIPLE_6_SCHEMA_H_
+#define _PRINCIPLE_6_SCHEMA_H_
+
+#include <string>
+
+namespace principle {
+
+
+/***
+ * JSON-Schema of principle-6 payload. (Command(CMD)-format in ICommand.h)
+ *  - Schema is compiled once at first use, and shared by all threads. (read-only)
+ *  - Payload is validated by SAX-pass, so DOM & principle-6 objects are not built for invalid payload.
+ ***/
+class CPrincipleSchema {
+public:
+    /** return false, if payload is not json-format or violates schema. (It does not throw exception.) */
+    static bool validate( const char* payload, size_t length, std::string* reason=NULL );
+
+private:
+    CPrincipleSchema(void) = delete;
+
+};
+
+
+}   // principle
+
+
+#endif // _PRINCIPLE_6_SCHEMA_H_
@@ -6,6 +6,7 @@
 
 #include <logger.h>
 #include <ICommand.h>
+#include <CPrincipleSchema.h>
 #include <Common.h>
 #include <CException.h>
 #include <time_kes.h>
@@ -14,6 +15,12 @@
 namespace cmd {
 
 constexpr const char* ICommand::VERSION;
+constexpr uint8_t ICommand::SECTION_WHO;
+constexpr uint8_t ICommand::SECTION_WHEN;
+constexpr uint8_t ICommand::SECTION_WHERE;
+constexpr uint8_t ICommand::SECTION_WHAT;
+constexpr uint8_t ICommand::SECTION_HOW;
+constexpr uint8_t ICommand::SECTION_WHY;
 
 static std::string JKEY_VERSION            = "version";
 static std::string JKEY_WHO                = "who";
@@ -180,7 +187,6 @@ bool ICommand::decode(std::shared_ptr<IProtocolInf>& protocol) {
     }
 
     try {
-        Json_DataType json_manager;
         const char* payload = (const char*)protocol->get_payload(payload_size);
         if( payload == NULL ) {
             LOGERR("Payload(0x%X) is NULL or length(%u) < 0.", payload, payload_size);
@@ -188,29 +194,15 @@ bool ICommand::decode(std::shared_ptr<IProtocolInf>& protocol) {
         }
 
         if( is_parsed() == false) {
-            // parsing json payload (where, what, how, why)
-            json_manager = std::make_shared<json_mng::CMjson>();
+            // keep json payload. (where, what, how, why are decoded at first access.)
             LOGD("payload=%s , length=%d", payload, payload_size);
-            if( json_manager->parse(payload, payload_size) != true) {
-                throw std::runtime_error("Invalid Json-payload. Please check it.");
-            }
-            _payload_ = std::string( json_manager->print_buf() );
-            LOGD("_payload_=%s", _payload_.data());
-
-            // check UniversalCMD version.
-            auto ver = extract_version(json_manager);
-            if( ver != version() ) {
-                std::string err = "VERSION(" + ver + ") of json-context != " + version();
-                throw std::invalid_argument(err);
+            reset_sections();
+            set_raw_payload( payload, payload_size );
+
+            // reject malformed CMD before any principle-6 object is built.
+            if( validate_payload() == false ) {
+                return false;
             }
-            // parse principle-6.
-            _who_ = extract_who(json_manager);
-            _when_ = extract_when(json_manager);
-            _where_ = extract_where(json_manager);
-            _what_ = extract_what(json_manager);
-            _how_ = extract_how(json_manager);
-            _why_ = extract_why(json_manager);
-            LOGD( "Success parse of Json buffer." );
 
             // mark receive-time of this packet using my-system time.
             set_flag_parse( true );
@@ -219,6 +211,7 @@ bool ICommand::decode(std::shared_ptr<IProtocolInf>& protocol) {
     catch ( const std::exception& e ) {
         LOGERR("%s", e.what());
         _payload_.clear();
+        _json_.reset();
         throw CException(E_ERROR::E_ERR_FAIL_DECODING_CMD);
     }
 
@@ -236,6 +229,7 @@ std::shared_ptr<payload::CPayload> ICommand::encode( std::shared_ptr<ICommunicat
 
     try {
         Json_DataType json_manager;
+        decode_sections();
         json_manager = std::make_shared<json_mng::CMjson>();
         message = handler->create_payload();
         if( message.get() == NULL ) {
@@ -269,16 +263,14 @@ void ICommand::set_when( std::string type, double start_time,
                                            Twhen::TEweek week, 
                                            uint32_t period, 
                                            double latency ) {
-    _when_.reset();
-    _when_ = std::make_shared<Twhen>(type, start_time, week, period, latency);
+    set_section( _when_, SECTION_WHEN, std::make_shared<Twhen>(type, start_time, week, period, latency) );
 }
 
 void ICommand::set_how( std::string method, std::string post_method, double costtime ) {
     try {
-        _how_.reset();
         auto method_pre = principle::type_convert<principle::Tvalve_method>(method);
         auto method_post = principle::type_convert<principle::Tvalve_method>(post_method);
-        _how_ = std::make_shared<Thow>(Thow::TYPE_VALVE, method_pre, costtime, method_post);
+        set_section( _how_, SECTION_HOW, std::make_shared<Thow>(Thow::TYPE_VALVE, method_pre, costtime, method_post) );
     }
     catch( const std::exception& e ) {
         LOGERR("%s", e.what());
@@ -346,63 +338,27 @@ E_CMPTIME ICommand::compare_with_another(ICommand *cmd, double duty) {
 }
 
 ICommand::Twho& ICommand::who(void) { 
-    if( is_parsed() == false ) {
-        throw std::logic_error("Twho Parsing is not complete.");
-    }
-    if( _who_.get() == NULL ) {
-        throw std::out_of_range("Twho is NULL.");
-    }
-    return *_who_; 
+    return get_section( _who_, SECTION_WHO, "Twho", [](Json_DataType& json) { return extract_who(json); } );
 }
 
 ICommand::Twhen& ICommand::when(void) { 
-    if( is_parsed() == false ) {
-        throw std::logic_error("Twhen Parsing is not complete.");
-    }
-    if( _when_.get() == NULL ) {
-        throw std::out_of_range("Twhen is NULL.");
-    }
-    return *_when_; 
+    return get_section( _when_, SECTION_WHEN, "Twhen", [this](Json_DataType& json) { return extract_when(json, get_default_time()); } );
 }
 
 ICommand::Twhere& ICommand::where(void) { 
-    if( is_parsed() == false ) {
-        throw std::logic_error("Twhere Parsing is not complete.");
-    }
-    if( _where_.get() == NULL ) {
-        throw std::out_of_range("Twhere is NULL.");
-    }
-    return *_where_; 
+    return get_section( _where_, SECTION_WHERE, "Twhere", [](Json_DataType& json) { return extract_where(json); } );
 }
 
 ICommand::Twhat& ICommand::what(void) { 
-    if( is_parsed() == false ) {
-        throw std::logic_error("Twhat Parsing is not complete.");
-    }
-    if( _what_.get() == NULL ) {
-        throw std::out_of_range("Twhat is NULL.");
-    }
-    return *_what_; 
+    return get_section( _what_, SECTION_WHAT, "Twhat", [](Json_DataType& json) { return extract_what(json); } );
 }
 
 ICommand::Thow& ICommand::how(void) { 
-    if( is_parsed() == false ) {
-        throw std::logic_error("Thow Parsing is not complete.");
-    }
-    if( _how_.get() == NULL ) {
-        throw std::out_of_range("Thow is NULL.");
-    }
-    return *_how_; 
+    return get_section( _how_, SECTION_HOW, "Thow", [](Json_DataType& json) { return extract_how(json); } );
 }
 
 ICommand::Twhy& ICommand::why(void) { 
-    if( is_parsed() == false ) {
-        throw std::logic_error("Twhy Parsing is not complete.");
-    }
-    if( _why_.get() == NULL ) {
-        throw std::out_of_range("Twhy is NULL.");
-    }
-    return *_why_; 
+    return get_section( _why_, SECTION_WHY, "Twhy", [](Json_DataType& json) { return extract_why(json); } );
 }
 
 
@@ -418,6 +374,81 @@ void ICommand::set_flag_parse( bool value, double rcv_time ) {
     }
 }
 
+void ICommand::set_raw_payload( const char* payload, size_t payload_size ) {
+    while( payload_size > 0 && payload[payload_size-1] == '\0' ) {
+        payload_size--;
+    }
+    _payload_.assign( payload, payload_size );
+}
+
+std::string ICommand::get_json_payload(void) const {
+    if( principle::CPrincipleReader::is_binary(_payload_.c_str(), _payload_.length()) == true ) {
+        return principle::CPrincipleReader::to_json( _payload_.c_str(), _payload_.length() );
+    }
+    return _payload_;
+}
+
+bool ICommand::validate_payload(void) {
+    std::string reason;
+    bool is_valid = false;
+
+    if( principle::CPrincipleReader::is_binary(_payload_.c_str(), _payload_.length()) == true ) {
+        // binary-body has known keys only, and values are checked when sections are built.
+        is_valid = principle::CPrincipleReader::is_valid_binary( _payload_.c_str(), _payload_.length(), &reason );
+    }
+    else {
+        is_valid = principle::CPrincipleSchema::validate( _payload_.c_str(), _payload_.length(), &reason );
+    }
+
+    if( is_valid == false ) {
+        LOGW("CMD-format is invalid. (%s)", reason.c_str());
+        _payload_.clear();
+        return false;
+    }
+    return true;
+}
+
+void ICommand::decode_sections(void) {
+    if( is_parsed() == false || _payload_.empty() == true ) {
+        return;
+    }
+
+    who();
+    when();
+    where();
+    what();
+    how();
+    why();
+}
+
+void ICommand::copy_sections(const ICommand& cmd) {
+    std::lock_guard<std::mutex> guard(cmd._mtx_sections_);
+
+    _who_ = cmd._who_;
+    _when_ = cmd._when_;
+    _where_ = cmd._where_;
+    _what_ = cmd._what_;
+    _how_ = cmd._how_;
+    _why_ = cmd._why_;
+    _payload_ = cmd._payload_;      // DOM is not shared, so not-decoded sections are parsed from payload again.
+    _m_sections_.store( cmd._m_sections_.load() );
+    _m_is_read_ = false;
+}
+
+void ICommand::reset_sections(void) {
+    std::lock_guard<std::mutex> guard(_mtx_sections_);
+
+    _who_.reset();
+    _when_.reset();
+    _where_.reset();
+    _what_.reset();
+    _how_.reset();
+    _why_.reset();
+    _json_.reset();
+    _m_sections_.store( 0 );
+    _m_is_read_ = false;
+}
+
 std::string ICommand::extract_version(Json_DataType &json) {
     return json->get_member(JKEY_VERSION);
 }
@@ -718,16 +749,99 @@ bool ICommand::apply_why(Json_DataType &json, std::shared_ptr<Twhy>& value) {
 /***********************************
  * Definition of Private Function.
  */
+Json_DataType& ICommand::get_dom(void) {
+    if( _json_.get() != NULL ) {
+        return _json_;
+    }
+
+    std::string payload = get_json_payload();
+    auto json_manager = std::make_shared<json_mng::CMjson>();
+    if( json_manager->parse(payload.c_str(), payload.length()) != true) {
+        throw std::runtime_error("Invalid Json-payload. Please check it.");
+    }
+
+    // check UniversalCMD version.
+    auto ver = extract_version(json_manager);
+    if( ver != version() ) {
+        std::string err = "VERSION(" + ver + ") of json-context != " + version();
+        throw std::invalid_argument(err);
+    }
+
+    LOGD( "Success parse of Json buffer." );
+    _json_ = json_manager;
+    return _json_;
+}
+
+void ICommand::read_sections(void) {
+    principle::CPrincipleReader reader( get_default_time() );
+    uint8_t decoded = _m_sections_.load(std::memory_order_relaxed);
+    _m_is_read_ = true;
+
+    reader.parse( _payload_.c_str(), _payload_.length() );
+
+    // check UniversalCMD version.
+    if( reader.get_version() != version() ) {
+        std::string err = "VERSION(" + reader.get_version() + ") of json-context != " + version();
+        throw std::invalid_argument(err);
+    }
+
+    // sections that are set by setter are not overwritten.
+    uint8_t sections = reader.get_sections() & ~decoded;
+    if( sections & SECTION_WHO )    _who_ = reader.get_who();
+    if( sections & SECTION_WHEN )   _when_ = reader.get_when();
+    if( sections & SECTION_WHERE )  _where_ = reader.get_where();
+    if( sections & SECTION_WHAT )   _what_ = reader.get_what();
+    if( sections & SECTION_HOW )    _how_ = reader.get_how();
+    if( sections & SECTION_WHY )    _why_ = reader.get_why();
+
+    LOGD( "Sections(0x%02X) are decoded by SAX-reader.", sections );
+    _m_sections_.fetch_or( sections, std::memory_order_release );
+}
+
+template <typename T, typename Fextract>
+T& ICommand::get_section( std::shared_ptr<T>& section, uint8_t bit, const char* name, Fextract extract ) {
+    if( is_parsed() == false ) {
+        throw std::logic_error( std::string(name) + " Parsing is not complete." );
+    }
+
+    // Fast-path: section is already decoded or set.
+    if( (_m_sections_.load(std::memory_order_acquire) & bit) == 0 ) {
+        std::lock_guard<std::mutex> guard(_mtx_sections_);
+
+        if( (_m_sections_.load(std::memory_order_relaxed) & bit) == 0 ) {
+            if( _payload_.empty() == true ) {
+                throw std::out_of_range( std::string(name) + " is NULL." );
+            }
+
+            if( _m_is_read_ == false ) {
+                read_sections();
+            }
+
+            // DOM-path for section that SAX-reader can not decode. (Ex: 'db' contents)
+            if( (_m_sections_.load(std::memory_order_relaxed) & bit) == 0 ) {
+                section = extract( get_dom() );
+                _m_sections_.fetch_or( bit, std::memory_order_release );
+            }
+        }
+    }
+
+    if( section.get() == NULL ) {
+        throw std::out_of_range( std::string(name) + " is NULL." );
+    }
+    return *section;
+}
+
+template <typename T>
+void ICommand::set_section( std::shared_ptr<T>& section, uint8_t bit, std::shared_ptr<T> value ) {
+    std::lock_guard<std::mutex> guard(_mtx_sections_);
+    section = value;
+    _m_sections_.fetch_or( bit, std::memory_order_release );
+}
+
 void ICommand::clear(void) {
     set_flag_parse(false);
     _payload_.clear();
-
-    _who_.reset();
-    _when_.reset();
-    _where_.reset();
-    _what_.reset();
-    _how_.reset();
-    _why_.reset();
+    reset_sections();
 }
 
 
@@ -2,6 +2,8 @@
 #define _INTERFACE_COMMAND_H_
 
 #include <ctime>
+#include <mutex>
+#include <atomic>
 #include <string>
 #include <memory>
 
@@ -10,6 +12,7 @@
 #include <IProtocolInf.h>
 #include <Common.h>
 #include <Principle6.h>
+#include <CPrincipleReader.h>
 
 
 /*******************************
@@ -174,8 +177,12 @@ public:
 
     double get_rcv_time(void) const { return _rcv_time_; }
 
+    /** Received body as it is. (json-text or binary-body of CPrincipleReader) */
     const std::string& get_payload(void) const { return _payload_; }
 
+    /** Received body as json-text. (binary-body is converted to json-text.) */
+    std::string get_json_payload(void) const;
+
     // setter
     void set_when( std::string type, double start_time, 
                                      Twhen::TEweek week = Twhen::TEweek::E_WEEK_NONE, 
@@ -191,7 +198,7 @@ public:
     E_CMPTIME compare_with_another(ICommand *cmd, double duty=1.0);   // check whether cmd-time is over/under/equal corespond to another cmd-time.
 
     /***
-     * Principle-6
+     * Principle-6 (Each section is decoded from payload at first access.)
      */
     Twho& who(void);
 
@@ -236,11 +243,41 @@ public:
 protected:
     void set_flag_parse( bool value, double rcv_time=0.0 );
 
+    /** Keep received bytes as canonical payload. (without trailing NULL-characters) */
+    void set_raw_payload( const char* payload, size_t payload_size );
+
+    /** Validate _payload_ by JSON-Schema or structure of binary-body.
+     *  (If it's invalid, _payload_ is cleared and return false without exception.) */
+    bool validate_payload(void);
+
+    /** Default start-time of 'when' section. */
+    virtual double get_default_time(void) const { return 0.0; }
+
+    /** Decode all of sections that are not decoded yet. (Ex: before encoding) */
+    void decode_sections(void);
+
+    /** Copy principle-6 sections & payload of another CMD. */
+    void copy_sections(const ICommand& cmd);
+
+    void reset_sections(void);
+
 private:
     ICommand(void) = delete;
 
     void clear(void);
 
+    /** Parse _payload_ to DOM, if it's not parsed yet. (It must be called in lock of _mtx_sections_.) */
+    Json_DataType& get_dom(void);
+
+    /** Decode sections in one pass by SAX-reader. (It must be called in lock of _mtx_sections_.) */
+    void read_sections(void);
+
+    template <typename T, typename Fextract>
+    T& get_section( std::shared_ptr<T>& section, uint8_t bit, const char* name, Fextract extract );
+
+    template <typename T>
+    void set_section( std::shared_ptr<T>& section, uint8_t bit, std::shared_ptr<T> value );
+
 protected:
     // Principle-6: Who, When, Where, What, How, Why
     std::shared_ptr<Twho> _who_;
@@ -255,7 +292,23 @@ protected:
 
     std::shared_ptr<Twhy> _why_;
 
-    std::string _payload_;      // json-data of payload
+    std::string _payload_;      // json-data or binary-body of payload (received bytes as it is)
+
+    Json_DataType _json_;       // DOM of _payload_ for sections that SAX-reader can not decode.
+
+    /** Bits of principle-6 sections that are decoded or set. */
+    static constexpr uint8_t SECTION_WHO = principle::CPrincipleReader::SECTION_WHO;
+    static constexpr uint8_t SECTION_WHEN = principle::CPrincipleReader::SECTION_WHEN;
+    static constexpr uint8_t SECTION_WHERE = principle::CPrincipleReader::SECTION_WHERE;
+    static constexpr uint8_t SECTION_WHAT = principle::CPrincipleReader::SECTION_WHAT;
+    static constexpr uint8_t SECTION_HOW = principle::CPrincipleReader::SECTION_HOW;
+    static constexpr uint8_t SECTION_WHY = principle::CPrincipleReader::SECTION_WHY;
+
+    std::atomic<uint8_t> _m_sections_;
+
+    bool _m_is_read_;           // _payload_ is already scanned by SAX-reader.
+
+    mutable std::mutex _mtx_sections_;
 
 private:
     // Data-Structure for Encoded packet.
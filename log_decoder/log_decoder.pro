@@ -0,0 +1,42 @@
+TARGET = app_log_decoder
+TEMPLATE = app
+QT -= gui core
+
+VER_MAJ = 0
+VER_MIN = 1
+VER_PAT = 0
+VERSION = $$VER_MAJ"."$$VER_MIN"."$$VER_PAT
+
+!include ($$_PRO_FILE_PWD_/../common_config.pri) {
+    message( "Not exist common_config.pri file." )
+}
+
+# for building
+COMMON_LIB_ROOT=$$_PRO_FILE_PWD_/../common
+
+DEFINES += LOGGER_TAG=\\\"DECODER\\\"
+# decoder is host-tool, so it prints to stdout only.
+DEFINES += LOG_MODE_STDOUT
+DEFINES += LOG_LEVEL=$$LOG_LEVEL_INFO
+
+
+# Make Incloude Path ##############################
+INCLUDEPATH += \
+    $$COMMON_LIB_ROOT/lib/logger
+
+# Make Sources ##############################
+SOURCES += \
+    $$files($$COMMON_LIB_ROOT/lib/logger/*.cpp) \
+    $$files($$_PRO_FILE_PWD_/source/*.cpp)
+
+# Make Libraries ##############################
+LIBS += -lpthread
+
+
+# for installation.
+EXTRA_BINFILES = \
+    $$_PRO_FILE_PWD_/$$TARGET
+
+!include ($$_PRO_FILE_PWD_/../deploy.pri) {
+    message( "Not exist sdk_deploy.pri file." )
+}
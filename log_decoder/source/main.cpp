@@ -0,0 +1,84 @@
+/***************************************************************************
+ *
+ * Host-side decoder of binary log-file. (captured by LOG_BINARY_FILE env)
+ *  - It prints records in order of sequence as text-log.
+ *
+ * *************************************************************************/
+
+#include <ctime>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+
+#include <log_level.h>
+#include <binary_log_kes.h>
+
+using namespace logger_pkg;
+
+static const char* get_level_name( uint32_t level ) {
+    switch( level ) {
+    case LOG_LEVEL_ERR:     return "E";
+    case LOG_LEVEL_WARN:    return "W";
+    case LOG_LEVEL_INFO:    return "I";
+    case LOG_LEVEL_DEBUG:   return "D";
+    default:                return "?";
+    }
+}
+
+/** monotonic time of slot -> real-time. ([%Y-%m-%d][%T.msec]) */
+static std::string get_time_str( const CBinaryLog::CHeader& header, uint64_t time_ns ) {
+    int64_t real_ns = static_cast<int64_t>(header.base_real_ns) +
+                      (static_cast<int64_t>(time_ns) - static_cast<int64_t>(header.base_mono_ns));
+    time_t sec = static_cast<time_t>(real_ns / 1000000000LL);
+    char time_str[32] = "";
+    char msec_str[16] = "";
+    tm cur_tm;
+
+    localtime_r( &sec, &cur_tm );
+    strftime( time_str, sizeof(time_str), "[%Y-%m-%d][%T", &cur_tm );
+    snprintf( msec_str, sizeof(msec_str), ".%03lld]", static_cast<long long>((real_ns / 1000000LL) % 1000LL) );
+    return std::string(time_str) + msec_str;
+}
+
+int main(int argc, char *argv[])
+{
+    if( argc != 2 && argc != 3 ) {
+        std::cout << "===========================================" << std::endl;
+        std::cout << "= Please insert following arguments." << std::endl;
+        std::cout << "=  - arg-01: path of binary log-file." << std::endl;
+        std::cout << "=  - arg-02: (optional) max log-level to print. [1:ERR, 2:WARN, 3:INFO, 4:DEBUG(default)]" << std::endl;
+        std::cout << std::endl;
+        return -1;
+    }
+
+    uint32_t max_level = (argc == 3 ? static_cast<uint32_t>(strtoul(argv[2], NULL, 10)) : LOG_LEVEL_DEBUG);
+    CBinaryLog::CHeader header;
+    std::vector<std::string> formats;
+    std::vector<CBinaryLog::CSlot> slots;
+    std::string error;
+
+    if( CBinaryLog::load(argv[1], header, formats, slots, error) == false ) {
+        std::cerr << "[ERROR] " << error << std::endl;
+        return -1;
+    }
+
+    CAsyncLogger::CRecord record;
+    std::string line;
+    for( auto itr=slots.begin(); itr!=slots.end(); itr++ ) {
+        if( itr->level > max_level ) {
+            continue;
+        }
+
+        const char* fmt = (itr->site < formats.size() ? formats[itr->site].c_str() : NULL);
+        CBinaryLog::to_record( *itr, fmt, record );
+        CAsyncLogger::format( record, line );
+        std::cout << get_time_str(header, itr->time_ns) << "[" << get_level_name(itr->level) << "] " << line << "\n";
+    }
+
+    // summary
+    uint64_t overwritten = (slots.empty() == true ? 0 : slots.front().seq - 1);
+    std::cerr << "tag=" << std::string(header.tag, strnlen(header.tag, sizeof(header.tag)))
+              << ", call-sites=" << formats.size() << ", records=" << slots.size()
+              << ", overwritten=" << overwritten << std::endl;
+    return 0;
+}
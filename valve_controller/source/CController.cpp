@@ -18,6 +18,8 @@ namespace valve_pkg {
 
 constexpr const char* CController::OPEN;
 constexpr const char* CController::CLOSE;
+constexpr double CController::ACT_ERROR_LIMIT;
+constexpr double CController::MAX_WAIT_SEC;
 
 /*********************************
  * Definition of Public Function.
@@ -54,8 +56,13 @@ void CController::init(std::shared_ptr<::comm::MCommunicator>& comm) {
         throw CException(E_ERROR::E_ERR_FAIL_INITE_GPIO_ROOT);
     }
 
+    if( init_valve_map() == false ) {
+        LOGERR("Loading of Valve-Map is failed.");
+        throw CException(E_ERROR::E_ERR_FAIL_LOADING_VALVE_MAP);
+    }
+
     _is_continue_ = false;
-    _cmd_list_.clear();
+    _mm_cmds_.clear();
 
     create_threads();
 }
@@ -68,7 +75,7 @@ void CController::soft_exit(void) {
         destroy_threads();
     }
 
-    _cmd_list_.clear();
+    _mm_cmds_.clear();
     _comm_.reset();
 }
 
@@ -76,6 +83,13 @@ bool CController::create_threads(void) {
     _is_continue_ = true;
     set_state(E_STATE::E_STATE_THR_CMD, 0);
 
+    _m_pwroff_queue_ = std::make_shared<TPwrOffQueue>();
+    this->_runner_valve_pwroff_ = std::thread(&CController::run_valve_pwroff, this);
+    if ( this->_runner_valve_pwroff_.joinable() == false ) {
+        LOGERR("run_valve_pwroff thread creating is failed.");
+        _is_continue_ = false;
+    }
+
     this->_runner_exe_cmd_ = std::thread(&CController::run_cmd_execute, this);
     if ( this->_runner_exe_cmd_.joinable() == false ) {
         LOGERR("run_cmd_execute thread creating is failed.");
@@ -85,20 +99,45 @@ bool CController::create_threads(void) {
 }
 
 void CController::destroy_threads(void) {
-    _is_continue_ = false;
-
-    // Destroy of POWER-off-threads for Each-valve.
-    for(int i=0; i < E_VALVE::E_VALVE_CNT; i++) {
-        std::thread &h_thread = _runner_valve_pwroff_[i];
-        if( h_thread.joinable() == true ) {
-            h_thread.join();
-        }
+    {
+        std::lock_guard<std::mutex> guard(_mtx_cmds_);
+        _is_continue_ = false;
     }
+    _m_cmd_cv_.notify_all();
 
-    // Destroy of CMD-Execute thread.
+    // Destroy of CMD-Execute thread. (After it, POWER-off is not scheduled anymore.)
     if(_runner_exe_cmd_.joinable() == true) {
         _runner_exe_cmd_.join();
     }
+
+    // Destroy of POWER-off-thread.
+    if( _m_pwroff_queue_.get() != NULL ) {
+        _m_pwroff_queue_->stop();
+    }
+
+    if( _runner_valve_pwroff_.joinable() == true ) {
+        _runner_valve_pwroff_.join();
+    }
+
+    // Valves must not be left with power, so pending POWER-off is run right now.
+    if( _m_pwroff_queue_.get() != NULL ) {
+        TPwrOffQueue::TVentry entries;
+        std::lock_guard<std::mutex> guard(_mtx_power_);
+
+        _m_pwroff_queue_->pop_all( entries );
+        for( auto itr=_mm_powered_.begin(); itr!=_mm_powered_.end(); itr++ ) {
+            LOGW("Pending POWER-off of valve(%u) is run at termination.", itr->first);
+            power_off( itr->second, true );
+        }
+        _mm_powered_.clear();
+        _m_pwroff_queue_.reset();
+    }
+
+    if( _m_act_error_.count > 0 ) {
+        LOGI("Actuation-error: count=%llu, avg=%.3f ms, max=%.3f ms, over(%.0f ms)=%llu", 
+             (unsigned long long)_m_act_error_.count, _m_act_error_.sum / _m_act_error_.count * 1000.0, 
+             _m_act_error_.max * 1000.0, ACT_ERROR_LIMIT * 1000.0, (unsigned long long)_m_act_error_.over_cnt);
+    }
 }
 
 void CController::receive_command( std::shared_ptr<cmd::ICommand>& cmd ) {
@@ -124,7 +163,6 @@ void CController::receive_command( std::shared_ptr<cmd::ICommand>& cmd ) {
 void CController::set_service_indicator( bool state ) {
     try {
         int t_gpio_value = 1;
-        std::string t_gpio = _gpio_root_path_ + "/gpio12/value";
 
         // decide gpio-pin value according to state.
         if( state == true ) {
@@ -136,7 +174,7 @@ void CController::set_service_indicator( bool state ) {
         }
 
         // write GPIO with value.
-        if( set_gpio(t_gpio, t_gpio_value) == false ) {
+        if( set_gpio(_m_valves_.get_indicator_pin(), t_gpio_value) == false ) {
             throw std::runtime_error("Failed write GPIO for valve-control.");
         }
     }
@@ -152,19 +190,51 @@ void CController::set_service_indicator( bool state ) {
 void CController::clear(void) {
     _comm_.reset();
     _is_continue_=false;       // Thread continue-flag.
-    _cmd_list_.clear();     // cmd encode/decode for valve-controling.
+    _mm_cmds_.clear();      // CMDs for valve-controling.
     _gpio_root_path_.clear();
+    _m_act_error_ = {0, 0, 0.0, 0.0};
+    _m_valves_.clear();
+    if( _m_gpio_.get() != NULL ) {
+        _m_gpio_->close_all();
+        _m_gpio_.reset();
+    }
     _m_myself_.reset();
 }
 
 bool CController::init_gpio_root(void) {
     const char* VALVE_GPIO_ROOT = getenv("VALVE_GPIO_ROOT");
-    if( VALVE_GPIO_ROOT == NULL ) {
+    const char* VALVE_GPIO_BACKEND = getenv("VALVE_GPIO_BACKEND");
+    std::string backend = (VALVE_GPIO_BACKEND != NULL ? VALVE_GPIO_BACKEND : IGpio::TYPE_SYSFS);
+
+    if( VALVE_GPIO_ROOT == NULL && backend != IGpio::TYPE_FAKE ) {
+        return false;
+    }
+
+    try {
+        _gpio_root_path_ = (VALVE_GPIO_ROOT != NULL ? VALVE_GPIO_ROOT : "");
+        LOGD("GPIO_ROOT_PATH=%s", _gpio_root_path_.c_str());
+
+        _m_gpio_ = IGpio::create( backend, _gpio_root_path_ );
+    }
+    catch( const std::exception& e ) {
+        LOGERR("%s", e.what());
+        return false;
+    }
+
+    return true;
+}
+
+bool CController::init_valve_map(void) {
+    const char* VALVE_MAP_PATH = getenv("VALVE_MAP_PATH");
+
+    try {
+        _m_valves_.load( VALVE_MAP_PATH != NULL ? VALVE_MAP_PATH : "" );
+    }
+    catch( const std::exception& e ) {
+        LOGERR("%s", e.what());
         return false;
     }
 
-    _gpio_root_path_ = VALVE_GPIO_ROOT;
-    LOGD("GPIO_ROOT_PATH=%s", _gpio_root_path_.c_str());
     return true;
 }
 
@@ -189,63 +259,49 @@ bool CController::push_cmd(std::shared_ptr<CMDType> cmd) {
 }
 
 bool CController::insert_cmd(std::shared_ptr<CMDType> cmd) {
-    CMDlistType::iterator itor;
-    cmd::E_CMPTIME state;
+    bool is_earliest = false;
     assert( cmd.get() != NULL );
     // assert( cmd->parsing_complet() == true );
 
     try {
-        std::lock_guard<std::mutex> guard(_mtx_cmd_list_);
-        itor = _cmd_list_.begin();
-
-        while( itor != _cmd_list_.end() ) {
-            // search position in _cmd_list_.
-            state = (*(itor))->compare_with_another(cmd.get(), 0.0);
-            assert( state != cmd::E_CMPTIME::E_CMPTIME_UNKNOWN);
-            if ( state == cmd::E_CMPTIME::E_CMPTIME_OVER )
-                break;
-            
-            itor++;
-        }
+        double start_time = cmd->when().get_start_time();
+        std::lock_guard<std::mutex> guard(_mtx_cmds_);
 
-        // insert cmd to list.
-        _cmd_list_.insert(itor, cmd);
+        // insert cmd to map. (CMD of same start-time is inserted after pre-inserted CMDs.)
+        auto itor = _mm_cmds_.insert( std::make_pair(start_time, cmd) );
+        is_earliest = (itor == _mm_cmds_.begin());
     }
     catch (const std::exception &e) {
         LOGERR("%s", e.what());
         throw e;
     }
+
+    // Executor have to re-calculate its wake-up time.
+    if( is_earliest == true ) {
+        _m_cmd_cv_.notify_all();
+    }
     
     return true;
 }
 
-std::shared_ptr<CController::CMDlistType> CController::pop_tasks(void) {
+/** Pop CMDs that start-time is reached. */
+std::shared_ptr<CController::CMDlistType> CController::pop_tasks(double cur_time) {
     // Search Task-List to do task.
     uint32_t count = 0;
-    uint32_t total_cnt = 0;
     std::shared_ptr<CMDlistType> cmds_to_exe = std::make_shared<CMDlistType>();
 
     try {
-        std::lock_guard<std::mutex> guard(_mtx_cmd_list_);
-        auto itor = _cmd_list_.begin();
-        total_cnt = _cmd_list_.size();
+        std::lock_guard<std::mutex> guard(_mtx_cmds_);
+        auto itor = _mm_cmds_.begin();
+        auto itor_end = _mm_cmds_.upper_bound( cur_time );
 
-        while( itor != _cmd_list_.end() ) {
-            auto valve_cmd = *itor;
+        while( itor != itor_end ) {
             count++;
-            if( count > total_cnt ) {
-                std::string err = "Inserted CMD count(" + std::to_string(count) + ") is over than size of original CMD-List.(" + std::to_string(total_cnt) + ")";
-                throw std::logic_error(err);
-            }
-
-            if( valve_cmd->compare_with_curtime() == cmd::E_CMPTIME::E_CMPTIME_OVER ) {
-                break;
-            }
-
             LOGI("Insert \"CMD_%u\" to execute command.", count);
-            cmds_to_exe->push_back(valve_cmd);
-            itor = _cmd_list_.erase(itor);
+            cmds_to_exe->push_back( itor->second );
+            itor++;
         }
+        _mm_cmds_.erase( _mm_cmds_.begin(), itor_end );
     }
     catch( const std::exception& e ) {
         LOGERR("%s", e.what());
@@ -255,6 +311,14 @@ std::shared_ptr<CController::CMDlistType> CController::pop_tasks(void) {
     return cmds_to_exe;
 }
 
+/** Start-time of earliest CMD. (NONE: return < 0) */
+double CController::get_next_time(void) {
+    if( _mm_cmds_.empty() == true ) {
+        return -1.0;
+    }
+    return _mm_cmds_.begin()->first;
+}
+
 void CController::execute_cmds(std::shared_ptr<CMDlistType> &cmds) {
     std::shared_ptr<CMDType> valve_cmd;
     CMDlistType::iterator itor = cmds->begin();
@@ -264,43 +328,24 @@ void CController::execute_cmds(std::shared_ptr<CMDlistType> &cmds) {
         valve_cmd = *itor;
 
         try {
-            // Wait pre-runned thread (valve power disable)
-            LOGD("Try to join of pre-runned thread.");
-            std::thread &h_thread = _runner_valve_pwroff_[valve_cmd->what().valve_which()];
-            if (h_thread.joinable()) {
-                h_thread.join();
-            }
+            uint32_t valve = valve_cmd->what().valve_which();
+            // POWER-off thread can be between popping & GPIO-writing of previous CMD,
+            // so power of a valve is changed only in this lock.
+            std::lock_guard<std::mutex> guard(_mtx_power_);
+
+            // If POWER-off of this valve is pending, then run it now. (Never wait for it.)
+            flush_pwroff( valve );
 
             // Act valve-command with power enable.
             LOGD("Power Enable & Act Valve-cmd.");
+            record_act_error( valve_cmd );
             if( execute_valve_cmd(valve_cmd, E_PWR::E_PWR_ENABLE) != true ) {
                 throw std::runtime_error("Executing valve-command is failed.");
             }
+            _mm_powered_[valve] = valve_cmd;
 
-            // Stop action of valve-command by power disable.
-            LOGD("Try creating thread.");
-            h_thread = std::thread([this](std::shared_ptr<CMDType> cmd) {
-                LOGD("Success Creating PWR_DISABLE thread.");
-                uint32_t wait_sec = 1;
-                auto& method = cmd->how().valve_method_pre();
-
-                switch( method ) {
-                case Tvalve_method::E_OPEN:
-                    wait_sec = WAITSEC_VALVE_OPEN;
-                    break;
-                case Tvalve_method::E_CLOSE:
-                    wait_sec = WAITSEC_VALVE_CLOSE;
-                    break;
-                default:
-                    LOGERR("Not Supported How.Tvalve_method(%u).", static_cast<uint32_t>(method));
-                    wait_sec = 1;
-                }
-                
-                std::this_thread::sleep_for(std::chrono::seconds(wait_sec));
-                if( execute_valve_cmd(cmd, E_PWR::E_PWR_DISABLE) != true ) {
-                    LOGERR("Executing valve-command is failed.");
-                }
-            }, valve_cmd);
+            // Stop action of valve-command by power disable. (It's run by POWER-off thread.)
+            schedule_pwroff( valve_cmd );
         }
         catch ( const std::exception& e ) {
             LOGERR("%s", e.what());
@@ -310,10 +355,85 @@ void CController::execute_cmds(std::shared_ptr<CMDlistType> &cmds) {
     }
 }
 
+void CController::schedule_pwroff(std::shared_ptr<CMDType> &valve_cmd) {
+    uint32_t wait_sec = 1;
+    auto& method = valve_cmd->how().valve_method_pre();
+    auto& valve_info = get_valve(valve_cmd);
+
+    switch( method ) {
+    case Tvalve_method::E_OPEN:
+        wait_sec = valve_info.pulse_open;
+        break;
+    case Tvalve_method::E_CLOSE:
+        wait_sec = valve_info.pulse_close;
+        break;
+    default:
+        LOGERR("Not Supported How.Tvalve_method(%u).", static_cast<uint32_t>(method));
+        wait_sec = 1;
+    }
+
+    if( _m_pwroff_queue_.get() == NULL ) {
+        throw std::logic_error("POWER-off queue is not created.");
+    }
+
+    uint32_t valve = valve_cmd->what().valve_which();
+    _m_pwroff_queue_->push( valve, TPwrOffQueue::now() + wait_sec, valve_cmd );
+    LOGD("POWER-off of valve(%u) is scheduled after %u sec.", valve, wait_sec);
+}
+
+void CController::flush_pwroff(uint32_t valve) {
+    auto itr = _mm_powered_.find( valve );
+
+    if( _m_pwroff_queue_.get() == NULL || itr == _mm_powered_.end() ) {
+        return;
+    }
+
+    // Pulse is cut short only if its deadline is not reached yet.
+    // (If it's popped by POWER-off thread already, then the pulse is completed & the thread skips it. refer to run_valve_pwroff)
+    std::shared_ptr<CMDType> pending;
+    double deadline = TPwrOffQueue::NONE_DEADLINE;
+    bool is_interrupted = ( _m_pwroff_queue_->find(valve, pending, &deadline) == true && deadline > TPwrOffQueue::now() );
+
+    _m_pwroff_queue_->remove( valve );
+    if( is_interrupted == true ) {
+        LOGW("Pulse of valve(%u) is interrupted by next command. (remain=%.3f sec)", valve, deadline - TPwrOffQueue::now());
+    }
+    else {
+        LOGD("POWER-off of valve(%u) is pending, so it's run before next command.", valve);
+    }
+    power_off( itr->second, is_interrupted );
+    _mm_powered_.erase( itr );
+}
+
+void CController::power_off(std::shared_ptr<CMDType> &valve_cmd, bool is_interrupted) {
+    if( execute_valve_cmd(valve_cmd, is_interrupted ? E_PWR::E_PWR_INTERRUPT : E_PWR::E_PWR_DISABLE) != true ) {
+        LOGERR("Executing valve-command is failed.");
+    }
+}
+
+void CController::record_act_error(std::shared_ptr<CMDType> &valve_cmd) {
+    double error = time_pkg::CTime::get<double>() - valve_cmd->when().get_start_time();
+
+    _m_act_error_.count++;
+    _m_act_error_.sum += error;
+    if( error > _m_act_error_.max ) {
+        _m_act_error_.max = error;
+    }
+
+    if( error > ACT_ERROR_LIMIT ) {
+        _m_act_error_.over_cnt++;
+        LOGW("Actuation-error(%.3f ms) of valve(%u) is over than %.0f ms.", 
+             error * 1000.0, valve_cmd->what().valve_which(), ACT_ERROR_LIMIT * 1000.0);
+    }
+    else {
+        LOGD("Actuation-error = %.3f ms", error * 1000.0);
+    }
+}
+
 /** Valve Open/Close routin.*/
 bool CController::execute_valve_cmd(std::shared_ptr<CMDType> &valve_cmd, E_PWR power) {
     bool result = false;
-    std::string t_gpio;
+    Tpin t_gpio = 0;
     int t_gpio_value = 1;
 
     assert( _comm_.get() != NULL );
@@ -335,16 +455,18 @@ bool CController::execute_valve_cmd(std::shared_ptr<CMDType> &valve_cmd, E_PWR p
         cout << "why=" << valve_cmd->why() << endl;
         cout << "************************************" << endl;
         
-        // get gpio-path for control valve.
-        t_gpio = get_gpio_path(valve_cmd);
+        // get gpio-pin for control valve.
+        t_gpio = get_gpio_pin(valve_cmd);
         
-        // get gpio-pin value according to power-state.
+        // get gpio-pin value according to power-state & active-level of valve.
+        int active_level = get_valve(valve_cmd).active_level;
         switch(power) {
         case E_PWR::E_PWR_ENABLE:
-            t_gpio_value = 0;
+            t_gpio_value = active_level;
             break;
         case E_PWR::E_PWR_DISABLE:
-            t_gpio_value = 1;
+        case E_PWR::E_PWR_INTERRUPT:
+            t_gpio_value = (active_level == 0 ? 1 : 0);
             break;
         }
 
@@ -361,6 +483,13 @@ bool CController::execute_valve_cmd(std::shared_ptr<CMDType> &valve_cmd, E_PWR p
                 throw CException(E_ERROR::E_ERR_FAIL_SENDING_ACT_START);
             }
         }
+        else if( power==E_PWR::E_PWR_INTERRUPT && (valve_cmd->get_state() & E_STATE::E_STATE_REACT_ACTION_DONE) ) {
+            // action is not completed, so we have to send ACT_FAIL message instead of ACT_DONE.
+            if( _comm_->notify_action_fail(valve_cmd->get_from(), valve_cmd->get_id(), E_STATE::E_STATE_THR_CMD) != true ) {
+                LOGERR("Can not send ACT-Fail message.");
+                throw CException(E_ERROR::E_ERR_FAIL_SENDING_ACT_DONE);
+            }
+        }
         else if( power==E_PWR::E_PWR_DISABLE && (valve_cmd->get_state() & E_STATE::E_STATE_REACT_ACTION_DONE) ) {
             // if need it, then we have to send ACT_DONE message to server.
             if( _comm_->notify_action_done(valve_cmd->get_from(), valve_cmd->get_id(), E_STATE::E_STATE_THR_CMD) != true ) {
@@ -377,107 +506,53 @@ bool CController::execute_valve_cmd(std::shared_ptr<CMDType> &valve_cmd, E_PWR p
     return result;
 }
 
-std::string CController::get_gpio_path(std::shared_ptr<CMDType> &valve_cmd) {
-    int gpio_index = -1;
-    std::string t_gpio = _gpio_root_path_ + "/";
+const CValveMap::CValve& CController::get_valve(std::shared_ptr<CMDType> &valve_cmd) {
+    return _m_valves_.get( valve_cmd->what().valve_which() );
+}
+
+CController::Tpin CController::get_gpio_pin(std::shared_ptr<CMDType> &valve_cmd) {
+    Tpin t_gpio = 0;
 
     try {
+        // deal with 'what' (O(1) lookup of valve-map)
+        auto& valve = get_valve(valve_cmd);
+
         // deal with 'how'
         auto& method = valve_cmd->how().valve_method_pre();
         switch( method ) {
         case Tvalve_method::E_OPEN:
-            gpio_index = 0;
+            t_gpio = valve.open_pin;
             break;
         case Tvalve_method::E_CLOSE:
-            gpio_index = E_VALVE::E_VALVE_CNT;
+            t_gpio = valve.close_pin;
             break;
         default:
             LOGERR("Not supported How.Tvalve_method(%u).", static_cast<uint32_t>(method));
             throw CException(E_ERR_NOT_SUPPORTED_HOW);
         }
-        
-        // deal with 'what'
-        gpio_index += valve_cmd->what().valve_which();
-        switch(gpio_index){
-        /** Valve 01 */
-        case E_GPIO::E_VALVE_LEFT_01_OPEN:
-            t_gpio += "gpio107/value";      // PD11 pin-out
-            break;
-        case E_GPIO::E_VALVE_LEFT_01_CLOSE:
-            t_gpio += "gpio110/value";      // PD14 pin-out
-            break;
-        /** Valve 02 */
-        case E_GPIO::E_VALVE_LEFT_02_OPEN:
-            t_gpio += "gpio13/value";       // PA13 pin-out
-            break;
-        case E_GPIO::E_VALVE_LEFT_02_CLOSE:
-            t_gpio += "gpio14/value";       // PA14 pin-out
-            break;
-        /** Valve 03 */
-        case E_GPIO::E_VALVE_LEFT_03_OPEN:
-            t_gpio += "gpio15/value";       // PA15 pin-out
-            break;
-        case E_GPIO::E_VALVE_LEFT_03_CLOSE:
-            t_gpio += "gpio16/value";       // PA16 pin-out
-            break;
-        /** Valve 04 */
-        case E_GPIO::E_VALVE_LEFT_04_OPEN:
-            t_gpio += "gpio18/value";       // PA18 pin-out
-            break;
-        case E_GPIO::E_VALVE_LEFT_04_CLOSE:
-            t_gpio += "gpio19/value";       // PA19 pin-out
-            break;
-        default:
-            LOGW("Not supported Target-GPIO.(%d)", valve_cmd->what().valve_which());
-            throw CException(E_ERR_NOT_SUPPORTED_WHAT);
-        }
     }
     catch (const std::exception &e) {
         LOGERR("%s", e.what());
-        t_gpio.clear();
         throw dynamic_cast<const CException&>(e);
     }
 
     return t_gpio;
 }
 
-bool CController::set_gpio(std::string gpio_path, int value) {
+bool CController::set_gpio(Tpin pin, int value) {
     LOGD("Called.");
-    int sys_output = -1;
-    char *buf = NULL;
     bool result = false;
-    ssize_t buf_size = 0;
-    assert( gpio_path.empty() == false );
     assert( value == 0 || value == 1 );
     
     try {
-        // run command
-        if ( system(NULL) ) {
-            assert( (buf_size = 10+gpio_path.length()+1) > 11 );
-            assert( (buf = new char[buf_size]) != NULL );
-
-            assert( snprintf(buf, buf_size, "echo %d > %s", value, gpio_path.c_str()) > 0 );
-            LOGD("command: [%s]", buf);
-            sys_output = system(buf);
-            switch( sys_output ) {    // run command as bash shell
-            case -1:
-                LOGW("There is Error when you run command in system.");
-                throw CException(E_ERROR::E_ERR_FAIL_RUNNING_CMD);
-                break;
-            case 127:
-                LOGW("/bin/sh invoking is failed.");
-                throw CException(E_ERROR::E_ERR_FAIL_INVOKING_SHELL);
-            case 512:
-                LOGW("gpio_path(%s) is invalid.", gpio_path.c_str());
-                throw CException(E_ERROR::E_ERR_FAIL_INVOKING_SHELL);
-            default:
-                LOGI("Output of system(%s) is [%d].", buf, sys_output);
-                result = true;
-            }
+        if( _m_gpio_.get() == NULL ) {
+            throw CException(E_ERROR::E_ERR_FAIL_INITE_GPIO_ROOT);
         }
-        else {
-            LOGW("Command Processor is not available.");
-            throw CException(E_ERROR::E_ERR_FAIL_CHECKING_CMD_PROC);
+
+        // write value to pin by persistent handle. (without fork/exec of shell)
+        result = _m_gpio_->write(pin, value);
+        if( result == false ) {
+            LOGW("Writing gpio%u with %d is failed.", pin, value);
         }
     }
     catch( const std::exception& e ) {
@@ -485,11 +560,6 @@ bool CController::set_gpio(std::string gpio_path, int value) {
         result = false;
     }
 
-    // delete heap memory.
-    if( buf ) {
-        delete[] buf;
-        buf = NULL;
-    }
     return result;
 }
 
@@ -508,8 +578,9 @@ CController::CMDlistType CController::decompose_cmd(std::shared_ptr<CMDType> cmd
         state = state & ~(E_STATE::E_STATE_REACT_ACTION_START | E_STATE::E_STATE_REACT_ACTION_DONE);
 
         // Check invalid command.
-        if ( method == Tvalve_method::E_OPEN && costtime <= (double)WAITSEC_VALVE_OPEN ) {
-            std::string err = "Invalid-CMD is discarded. (method: Open, but costtime <= " + std::to_string(WAITSEC_VALVE_OPEN) + ")";
+        auto& valve = get_valve(cmd);
+        if ( method == Tvalve_method::E_OPEN && costtime <= (double)valve.pulse_open ) {
+            std::string err = "Invalid-CMD is discarded. (method: Open, but costtime <= " + std::to_string(valve.pulse_open) + ")";
             throw std::invalid_argument(err);
         }
 
@@ -553,22 +624,70 @@ CController::CMDlistType CController::decompose_cmd(std::shared_ptr<CMDType> cmd
  */
 int CController::run_cmd_execute(void) {
     LOGD("Called.");
-    int send_count = 0;
     std::shared_ptr<CMDlistType> cmds;
 
     while(_is_continue_) {
         cmds.reset();
 
-        // Check Current-Tasks & execute thoese.
-        cmds = pop_tasks();
-        if ( cmds->size() > 0 ) {
-            execute_cmds(cmds);
-            cmds.reset();
+        try {
+            // Check Current-Tasks & execute thoese.
+            cmds = pop_tasks( time_pkg::CTime::get<double>() );
+            if ( cmds->size() > 0 ) {
+                execute_cmds(cmds);
+                cmds.reset();
+                continue;       // time is passed while executing, so check it again.
+            }
+        }
+        catch( const std::exception& e ) {
+            LOGERR("%s", e.what());
+        }
+
+        // wait until start-time of next CMD, or insertion of earlier CMD.
+        std::unique_lock<std::mutex> lk(_mtx_cmds_);
+        if( _is_continue_ == false ) {
+            break;
+        }
+
+        double remain = MAX_WAIT_SEC;
+        double next_time = get_next_time();
+        if( next_time >= 0.0 ) {
+            remain = std::min( next_time - time_pkg::CTime::get<double>(), MAX_WAIT_SEC );
         }
 
-        // wait 300 ms
-        std::this_thread::sleep_for(std::chrono::milliseconds(300));
+        if( remain > 0.0 ) {
+            _m_cmd_cv_.wait_for( lk, std::chrono::duration<double>(remain) );
+        }
     }
+
+    LOGI("Exit CMD-Execute thread.");
+    return 0;
+}
+
+int CController::run_valve_pwroff(void) {
+    LOGD("Called.");
+    TPwrOffQueue::TVentry entries;
+
+    // Blocking until deadline of POWER-off is reached or stop() is called.
+    while( _m_pwroff_queue_->wait_pop( entries ) == true ) {
+        for( auto itr=entries.begin(); itr!=entries.end(); itr++ ) {
+            std::lock_guard<std::mutex> guard(_mtx_power_);
+            auto powered = _mm_powered_.find( itr->first );
+
+            // Executor can run it & enable next CMD of the valve after popping, so only current CMD is powered off.
+            if( powered == _mm_powered_.end() || powered->second != itr->second ) {
+                LOGD("POWER-off of valve(%u) is already run by executor.", itr->first);
+                continue;
+            }
+
+            LOGD("POWER-off of valve(%u).", itr->first);
+            power_off( itr->second );
+            _mm_powered_.erase( powered );
+        }
+        entries.clear();
+    }
+
+    LOGI("Exit POWER-off thread.");
+    return 0;
 }
 
 void CController::set_state(E_STATE pos, StateType value) {
@@ -0,0 +1,262 @@
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/gpio.h>
+
+#include <logger.h>
+
+#include <CGpio.h>
+
+namespace valve_pkg {
+
+constexpr const char* IGpio::TYPE_SYSFS;
+constexpr const char* IGpio::TYPE_CHARDEV;
+constexpr const char* IGpio::TYPE_FAKE;
+constexpr const char* CGpioChardev::CONSUMER;
+
+namespace {
+
+const char* const VALUE_STR[2] = { "0\n", "1\n" };
+
+inline void check_value( int value ) {
+    if( value != 0 && value != 1 ) {
+        std::string err = "GPIO value(" + std::to_string(value) + ") is invalid.";
+        throw std::invalid_argument(err);
+    }
+}
+
+inline std::string get_errno_str( void ) {
+    return std::string(strerror(errno)) + "(" + std::to_string(errno) + ")";
+}
+
+}   // namespace
+
+
+/*********************************
+ * Definition of IGpio Function.
+ */
+std::shared_ptr<IGpio> IGpio::create( const std::string& type, const std::string& root ) {
+    std::shared_ptr<IGpio> gpio;
+
+    try {
+        if( type.empty() == true || type == TYPE_SYSFS ) {
+            gpio = std::make_shared<CGpioSysfs>( root );
+        }
+        else if( type == TYPE_CHARDEV ) {
+            gpio = std::make_shared<CGpioChardev>( root );
+        }
+        else if( type == TYPE_FAKE ) {
+            gpio = std::make_shared<CGpioFake>();
+        }
+        else {
+            std::string err = "Not supported GPIO-backend(" + type + ").";
+            throw std::invalid_argument(err);
+        }
+
+        LOGI("GPIO-backend = %s (root=%s)", gpio->get_type(), root.c_str());
+    }
+    catch( const std::exception& e ) {
+        LOGERR("%s", e.what());
+        throw e;
+    }
+
+    return gpio;
+}
+
+
+/*********************************
+ * Definition of CGpioSysfs Function.
+ */
+CGpioSysfs::CGpioSysfs( const std::string& root )
+: _m_root_(root) {
+    if( _m_root_.empty() == true ) {
+        throw std::invalid_argument("GPIO-root of sysfs is empty.");
+    }
+}
+
+CGpioSysfs::~CGpioSysfs(void) {
+    close_all();
+}
+
+bool CGpioSysfs::write( Tpin pin, int value ) {
+    try {
+        check_value( value );
+
+        int fd = get_fd( pin );
+        if( pwrite(fd, VALUE_STR[value], 2, 0) != 2 ) {
+            std::string err = "Writing gpio" + std::to_string(pin) + " is failed. " + get_errno_str();
+            throw std::runtime_error(err);
+        }
+
+        LOGD("gpio%u = %d", pin, value);
+        return true;
+    }
+    catch( const std::exception& e ) {
+        LOGERR("%s", e.what());
+    }
+
+    return false;
+}
+
+void CGpioSysfs::close_all(void) {
+    std::lock_guard<std::mutex> guard(_mtx_fds_);
+
+    for( auto itr=_mm_fds_.begin(); itr!=_mm_fds_.end(); itr++ ) {
+        ::close( itr->second );
+    }
+    _mm_fds_.clear();
+}
+
+int CGpioSysfs::get_fd( Tpin pin ) {
+    std::lock_guard<std::mutex> guard(_mtx_fds_);
+
+    auto itr = _mm_fds_.find( pin );
+    if( itr != _mm_fds_.end() ) {
+        return itr->second;
+    }
+
+    std::string path = _m_root_ + "/gpio" + std::to_string(pin) + "/value";
+    int fd = ::open( path.c_str(), O_WRONLY | O_CLOEXEC );
+    if( fd < 0 ) {
+        std::string err = "Opening " + path + " is failed. " + get_errno_str();
+        throw std::runtime_error(err);
+    }
+
+    LOGI("Open %s (fd=%d)", path.c_str(), fd);
+    _mm_fds_[pin] = fd;
+    return fd;
+}
+
+
+/*********************************
+ * Definition of CGpioChardev Function.
+ */
+CGpioChardev::CGpioChardev( const std::string& root )
+: _m_root_(root), _m_chip_fd_(-1) {
+    if( _m_root_.empty() == true ) {
+        throw std::invalid_argument("GPIO-chip device path is empty.");
+    }
+
+    _m_chip_fd_ = ::open( _m_root_.c_str(), O_RDWR | O_CLOEXEC );
+    if( _m_chip_fd_ < 0 ) {
+        std::string err = "Opening " + _m_root_ + " is failed. " + get_errno_str();
+        throw std::runtime_error(err);
+    }
+}
+
+CGpioChardev::~CGpioChardev(void) {
+    close_all();
+
+    if( _m_chip_fd_ >= 0 ) {
+        ::close( _m_chip_fd_ );
+        _m_chip_fd_ = -1;
+    }
+}
+
+bool CGpioChardev::write( Tpin pin, int value ) {
+    try {
+        check_value( value );
+
+        int fd = get_fd( pin, value );
+        if( fd >= 0 ) {
+            struct gpiohandle_data data;
+            memset( &data, 0, sizeof(data) );
+            data.values[0] = static_cast<uint8_t>(value);
+
+            if( ioctl(fd, GPIOHANDLE_SET_LINE_VALUES_IOCTL, &data) < 0 ) {
+                std::string err = "Writing line(" + std::to_string(pin) + ") is failed. " + get_errno_str();
+                throw std::runtime_error(err);
+            }
+        }
+
+        LOGD("line%u = %d", pin, value);
+        return true;
+    }
+    catch( const std::exception& e ) {
+        LOGERR("%s", e.what());
+    }
+
+    return false;
+}
+
+void CGpioChardev::close_all(void) {
+    std::lock_guard<std::mutex> guard(_mtx_fds_);
+
+    for( auto itr=_mm_fds_.begin(); itr!=_mm_fds_.end(); itr++ ) {
+        ::close( itr->second );
+    }
+    _mm_fds_.clear();
+}
+
+int CGpioChardev::get_fd( Tpin pin, int value ) {
+    std::lock_guard<std::mutex> guard(_mtx_fds_);
+
+    auto itr = _mm_fds_.find( pin );
+    if( itr != _mm_fds_.end() ) {
+        return itr->second;
+    }
+
+    struct gpiohandle_request req;
+    memset( &req, 0, sizeof(req) );
+    req.lineoffsets[0] = pin;
+    req.lines = 1;
+    req.flags = GPIOHANDLE_REQUEST_OUTPUT;
+    req.default_values[0] = static_cast<uint8_t>(value);
+    strncpy( req.consumer_label, CONSUMER, sizeof(req.consumer_label) - 1 );
+
+    if( ioctl(_m_chip_fd_, GPIO_GET_LINEHANDLE_IOCTL, &req) < 0 || req.fd < 0 ) {
+        std::string err = "Requesting line(" + std::to_string(pin) + ") of " + _m_root_ + " is failed. " + get_errno_str();
+        throw std::runtime_error(err);
+    }
+
+    LOGI("Request line(%u) of %s (fd=%d)", pin, _m_root_.c_str(), req.fd);
+    _mm_fds_[pin] = req.fd;
+    return -1;      // value is already written by default_values.
+}
+
+
+/*********************************
+ * Definition of CGpioFake Function.
+ */
+bool CGpioFake::write( Tpin pin, int value ) {
+    try {
+        check_value( value );
+
+        std::lock_guard<std::mutex> guard(_mtx_values_);
+        _mm_values_[pin] = value;
+        _m_write_cnt_++;
+        return true;
+    }
+    catch( const std::exception& e ) {
+        LOGERR("%s", e.what());
+    }
+
+    return false;
+}
+
+void CGpioFake::close_all(void) {
+    std::lock_guard<std::mutex> guard(_mtx_values_);
+    _mm_values_.clear();
+}
+
+int CGpioFake::get_value( Tpin pin ) {
+    std::lock_guard<std::mutex> guard(_mtx_values_);
+
+    auto itr = _mm_values_.find( pin );
+    if( itr == _mm_values_.end() ) {
+        return -1;
+    }
+    return itr->second;
+}
+
+uint64_t CGpioFake::get_write_count(void) {
+    std::lock_guard<std::mutex> guard(_mtx_values_);
+    return _m_write_cnt_;
+}
+
+
+}   // namespace valve_pkg
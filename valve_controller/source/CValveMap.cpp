@@ -0,0 +1,178 @@
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#include <logger.h>
+#include <json_headers.h>
+
+#include <CValveMap.h>
+#include <CException.h>
+
+namespace valve_pkg {
+
+constexpr uint32_t CValveMap::MAX_VALVE_CNT;
+constexpr uint32_t CValveMap::DEFAULT_PULSE_SEC;
+constexpr int CValveMap::DEFAULT_ACTIVE_LEVEL;
+constexpr CValveMap::Tpin CValveMap::DEFAULT_INDICATOR_PIN;
+
+namespace {
+
+/** Default table for 4-valves board. */
+struct CDefaultValve {
+    uint32_t id;
+    CValveMap::Tpin open_pin;
+    CValveMap::Tpin close_pin;
+};
+
+const CDefaultValve DEFAULT_VALVES[] = {
+    { 0, 107, 110 },    // PD11, PD14 pin-out
+    { 1,  13,  14 },    // PA13, PA14 pin-out
+    { 2,  15,  16 },    // PA15, PA16 pin-out
+    { 3,  18,  19 }     // PA18, PA19 pin-out
+};
+
+uint32_t get_uint( const json_mng::Value_Type& obj, const char* key, uint32_t def_value, bool mandatory=false ) {
+    auto itr = obj.FindMember( key );
+    if( itr == obj.MemberEnd() ) {
+        if( mandatory == true ) {
+            throw std::invalid_argument( std::string("\"") + key + "\" is not exist." );
+        }
+        return def_value;
+    }
+
+    if( itr->value.IsUint() == false ) {
+        throw std::invalid_argument( std::string("\"") + key + "\" is not unsigned integer." );
+    }
+    return itr->value.GetUint();
+}
+
+}   // namespace
+
+
+/*********************************
+ * Definition of Public Function.
+ */
+CValveMap::CValveMap(void) {
+    clear();
+}
+
+void CValveMap::load( const std::string& path ) {
+    try {
+        clear();
+
+        if( path.empty() == true ) {
+            load_default();
+        }
+        else {
+            load_file( path );
+        }
+
+        if( _m_valve_cnt_ == 0 ) {
+            throw std::invalid_argument("There is no valve in table.");
+        }
+
+        LOGI("Valve-Map is loaded. (valves=%zu, max-id=%zu, indicator=%u)",
+             _m_valve_cnt_, _mv_valves_.size() - 1, _m_indicator_pin_);
+    }
+    catch( const std::exception& e ) {
+        LOGERR("%s", e.what());
+        clear();
+        throw CException(E_ERROR::E_ERR_FAIL_LOADING_VALVE_MAP);
+    }
+}
+
+const CValveMap::CValve& CValveMap::get( uint32_t valve_id ) const {
+    if( valve_id >= _mv_valves_.size() || _mv_valves_[valve_id].valid == false ) {
+        LOGW("Not supported valve-id(%u).", valve_id);
+        throw CException(E_ERROR::E_ERR_NOT_SUPPORTED_WHAT);
+    }
+    return _mv_valves_[valve_id];
+}
+
+void CValveMap::clear(void) {
+    _mv_valves_.clear();
+    _m_valve_cnt_ = 0;
+    _m_indicator_pin_ = DEFAULT_INDICATOR_PIN;
+}
+
+
+/*********************************
+ * Definition of Private Function.
+ */
+void CValveMap::load_default(void) {
+    LOGI("Load default Valve-Map.");
+
+    for( auto& def : DEFAULT_VALVES ) {
+        CValve valve = { true, def.open_pin, def.close_pin, DEFAULT_PULSE_SEC, DEFAULT_PULSE_SEC, DEFAULT_ACTIVE_LEVEL };
+        set( def.id, valve );
+    }
+}
+
+void CValveMap::load_file( const std::string& path ) {
+    LOGI("Load Valve-Map from %s", path.c_str());
+
+    std::ifstream file( path );
+    if( file.is_open() == false ) {
+        throw std::runtime_error( "Can not open " + path );
+    }
+
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+
+    json_mng::JsonManipulator doc;
+    doc.Parse( buffer.str().c_str() );
+    if( doc.HasParseError() == true || doc.IsObject() == false ) {
+        throw std::invalid_argument( "Invalid json-format of " + path );
+    }
+
+    _m_indicator_pin_ = get_uint( doc, "indicator", DEFAULT_INDICATOR_PIN );
+
+    auto itr_valves = doc.FindMember( "valves" );
+    if( itr_valves == doc.MemberEnd() || itr_valves->value.IsArray() == false ) {
+        throw std::invalid_argument( "\"valves\" array is not exist in " + path );
+    }
+
+    for( auto itr=itr_valves->value.Begin(); itr!=itr_valves->value.End(); itr++ ) {
+        if( itr->IsObject() == false ) {
+            throw std::invalid_argument("Element of \"valves\" is not object.");
+        }
+
+        uint32_t valve_id = get_uint( *itr, "id", 0, true );
+        CValve valve;
+        valve.valid = true;
+        valve.open_pin = get_uint( *itr, "open", 0, true );
+        valve.close_pin = get_uint( *itr, "close", 0, true );
+        valve.pulse_open = get_uint( *itr, "pulse_open", DEFAULT_PULSE_SEC );
+        valve.pulse_close = get_uint( *itr, "pulse_close", DEFAULT_PULSE_SEC );
+        valve.active_level = static_cast<int>( get_uint( *itr, "active_level", DEFAULT_ACTIVE_LEVEL ) );
+
+        if( valve.active_level != 0 && valve.active_level != 1 ) {
+            throw std::invalid_argument( "active_level of valve(" + std::to_string(valve_id) + ") is not 0 or 1." );
+        }
+        set( valve_id, valve );
+    }
+}
+
+void CValveMap::set( uint32_t valve_id, const CValve& valve ) {
+    if( valve_id >= MAX_VALVE_CNT ) {
+        std::string err = "valve-id(" + std::to_string(valve_id) + ") is over than MAX(" + std::to_string(MAX_VALVE_CNT) + ").";
+        throw std::out_of_range(err);
+    }
+
+    if( valve_id >= _mv_valves_.size() ) {
+        CValve invalid = { false, 0, 0, 0, 0, 0 };
+        _mv_valves_.resize( valve_id + 1, invalid );
+    }
+
+    if( _mv_valves_[valve_id].valid == true ) {
+        throw std::invalid_argument( "valve-id(" + std::to_string(valve_id) + ") is duplicated." );
+    }
+
+    _mv_valves_[valve_id] = valve;
+    _m_valve_cnt_++;
+    LOGD("valve(%u): open=%u, close=%u, pulse=%u/%u sec, active=%d", valve_id,
+         valve.open_pin, valve.close_pin, valve.pulse_open, valve.pulse_close, valve.active_level);
+}
+
+
+}   // namespace valve_pkg
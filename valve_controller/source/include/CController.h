@@ -2,14 +2,19 @@
 #define _VALVE_CONTROLLER_H_
 
 #include <list>
+#include <map>
 #include <string>
 #include <thread>
 #include <memory>
 #include <mutex>
+#include <condition_variable>
 
 #include <CuCMD/CuCMD.h>
 #include <Common.h>
 #include <CuCMD/MCommunicator.h>
+#include <CGpio.h>
+#include <CValveMap.h>
+#include <deadline_queue_kes.h>
 
 namespace valve_pkg {
 
@@ -20,36 +25,26 @@ public:
     using StateType = common::StateType;
     using CMDType = cmd::CuCMD;
     using CMDlistType = std::list<std::shared_ptr<CMDType>>;
+    using CMDmapType = std::multimap<double /*start-time*/, std::shared_ptr<CMDType>>;
     using E_PWR = enum E_PWR {
         E_PWR_DISABLE = 0,
-        E_PWR_ENABLE = 1
-    };
-    using E_GPIO = enum E_GPIO {
-        E_VALVE_LEFT_01_OPEN = 0,
-        E_VALVE_LEFT_02_OPEN = 1,
-        E_VALVE_LEFT_03_OPEN = 2,
-        E_VALVE_LEFT_04_OPEN = 3,
-        E_VALVE_LEFT_01_CLOSE = 4,
-        E_VALVE_LEFT_02_CLOSE = 5,
-        E_VALVE_LEFT_03_CLOSE = 6,
-        E_VALVE_LEFT_04_CLOSE = 7
+        E_PWR_ENABLE = 1,
+        E_PWR_INTERRUPT = 2     // power disable before end of pulse. (ACT-Fail is sent instead of ACT-Done.)
     };
 
 private:
     using Tvalve_method = ::principle::Tvalve_method;
     using Tdb_method = ::principle::Tdb_method;
+    using Tpin = IGpio::Tpin;
+    /** Pending POWER-off of valves. (key: valve-index, only one power-off per valve.)
+     *  Pulse-width is kept by steady-clock, even if wall-clock is changed by Time-Sync. */
+    using TPwrOffQueue = time_pkg::CDeadlineQueue<uint32_t, std::shared_ptr<CMDType>, std::chrono::steady_clock>;
+    /** CMD that is powered now per valve. (key: valve-index) */
+    using TPoweredMap = std::map<uint32_t, std::shared_ptr<CMDType>>;
 
     static constexpr const char* OPEN = "open";
     static constexpr const char* CLOSE = "close";
     
-    using E_VALVE = enum E_VALVE {
-        E_VALVE_NULL = -1,
-        E_VALVE_LEFT_01 = 0,
-        E_VALVE_LEFT_02 = 1,
-        E_VALVE_LEFT_03 = 2,
-        E_VALVE_LEFT_04 = 3,
-        E_VALVE_CNT = 4
-    };
 
 public:
     CController(void);
@@ -74,9 +69,21 @@ private:
 
     bool init_gpio_root(void);
 
+    bool init_valve_map(void);
+
     /** Thread-routin */
     int run_cmd_execute(void); // Execute command routin.
 
+    int run_valve_pwroff(void); // POWER-off routin of valves by deadline.
+
+    void schedule_pwroff(std::shared_ptr<CMDType> &valve_cmd);
+
+    void flush_pwroff(uint32_t valve);      // Run pending POWER-off of valve right now. (It must be called in lock of _mtx_power_.)
+
+    void power_off(std::shared_ptr<CMDType> &valve_cmd, bool is_interrupted=false);
+
+    void record_act_error(std::shared_ptr<CMDType> &valve_cmd);
+
     void set_state(E_STATE pos, StateType value);
 
     StateType get_state(E_STATE pos);
@@ -86,15 +93,19 @@ private:
     /** Functions with regard to CMD */
     bool insert_cmd(std::shared_ptr<CMDType> cmd);
 
-    std::shared_ptr<CMDlistType> pop_tasks(void);
+    std::shared_ptr<CMDlistType> pop_tasks(double cur_time);
+
+    double get_next_time(void);       // It must be called in lock of _mtx_cmds_.
 
     void execute_cmds(std::shared_ptr<CMDlistType> &cmds);
 
     bool execute_valve_cmd(std::shared_ptr<CMDType> &valve_cmd, E_PWR power);
 
-    std::string get_gpio_path(std::shared_ptr<CMDType> &valve_cmd);
+    const CValveMap::CValve& get_valve(std::shared_ptr<CMDType> &valve_cmd);
 
-    bool set_gpio(std::string gpio_path, int value);
+    Tpin get_gpio_pin(std::shared_ptr<CMDType> &valve_cmd);
+
+    bool set_gpio(Tpin pin, int value);
 
     CMDlistType decompose_cmd(std::shared_ptr<CMDType> cmd);
 
@@ -107,16 +118,37 @@ private:
     
     std::thread _runner_exe_cmd_; // Periodically, Thread that is charge of deciding & executing for received CMD.
 
-    std::thread _runner_valve_pwroff_[E_VALVE::E_VALVE_CNT];
+    std::thread _runner_valve_pwroff_;  // Single thread that is charge of POWER-off for all valves.
+
+    std::shared_ptr<TPwrOffQueue> _m_pwroff_queue_;
+
+    TPoweredMap _mm_powered_;   // POWER-off of these CMDs is not run yet. (It may be popped from queue already.)
+
+    std::mutex _mtx_power_;     // Power-enable & POWER-off of valves are serialized by it.
+
+    CMDmapType _mm_cmds_;       // CMDs for valve-controling ordered by start-time.
 
-    CMDlistType _cmd_list_;     // cmd encode/decode for valve-controling.
+    std::mutex _mtx_cmds_;
 
-    std::mutex _mtx_cmd_list_;
+    std::condition_variable _m_cmd_cv_;     // wake up executor, when earlier CMD is inserted.
+
+    /** Actuation error. (actual-time - planned-time of CMD) [seconds] */
+    struct CActError {
+        uint64_t count;
+        uint64_t over_cnt;      // count of error that is over than ACT_ERROR_LIMIT.
+        double sum;
+        double max;
+    } _m_act_error_;
 
     std::string _gpio_root_path_;
 
-    static constexpr uint32_t WAITSEC_VALVE_OPEN = 25;
-    static constexpr uint32_t WAITSEC_VALVE_CLOSE = 25;
+    std::shared_ptr<IGpio> _m_gpio_;    // GPIO back-end. (selected by VALVE_GPIO_BACKEND)
+
+    CValveMap _m_valves_;       // valve-id -> GPIO-pins. (loaded from VALVE_MAP_PATH)
+
+    static constexpr double ACT_ERROR_LIMIT = 0.02;     // [seconds]
+
+    static constexpr double MAX_WAIT_SEC = 1.0;         // re-check interval for wall-clock changing.
 
 };
 
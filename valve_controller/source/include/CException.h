@@ -49,6 +49,7 @@ typedef enum E_ERROR {
 
     E_ERR_EMPTY_CMD                 = 36,
     E_ERR_OUT_OF_SERVICE_VALVE,
+    E_ERR_FAIL_LOADING_VALVE_MAP,
 } E_ERROR;
 
 
@@ -164,6 +165,8 @@ private:
             return "E_ERR_EMPTY_CMD occured.";
         case E_ERR_OUT_OF_SERVICE_VALVE:
             return "E_ERR_OUT_OF_SERVICE_VALVE occured.";
+        case E_ERR_FAIL_LOADING_VALVE_MAP:
+            return "E_ERR_FAIL_LOADING_VALVE_MAP occured.";
         case E_NO_ERROR:
             LOGD("E_NO_ERROR occured.");
             break;
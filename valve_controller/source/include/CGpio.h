@@ -0,0 +1,145 @@
+#ifndef _VALVE_GPIO_H_
+#define _VALVE_GPIO_H_
+
+#include <map>
+#include <mutex>
+#include <memory>
+#include <string>
+#include <cstdint>
+
+namespace valve_pkg {
+
+
+/***
+ * Back-end of GPIO output-pins.
+ *  - Each pin is opened at first access, and its handle is re-used for next writing.
+ *  - write() does not fork/exec any process and does not allocate memory after first access.
+ ***/
+class IGpio {
+public:
+    using Tpin = uint32_t;
+
+    static constexpr const char* TYPE_SYSFS = "sysfs";
+    static constexpr const char* TYPE_CHARDEV = "chardev";
+    static constexpr const char* TYPE_FAKE = "fake";
+
+public:
+    virtual ~IGpio(void) = default;
+
+    /** Create back-end by type. (root: sysfs-gpio folder or gpio-chip device path.) */
+    static std::shared_ptr<IGpio> create( const std::string& type, const std::string& root );
+
+    virtual const char* get_type(void) const = 0;
+
+    virtual bool write( Tpin pin, int value ) = 0;
+
+    virtual void close_all(void) = 0;
+
+};
+
+
+/***
+ * sysfs back-end : "${root}/gpio${pin}/value" is opened once, and written by pwrite().
+ ***/
+class CGpioSysfs : public IGpio {
+public:
+    explicit CGpioSysfs( const std::string& root );
+
+    ~CGpioSysfs(void);
+
+    const char* get_type(void) const override { return TYPE_SYSFS; }
+
+    bool write( Tpin pin, int value ) override;
+
+    void close_all(void) override;
+
+private:
+    CGpioSysfs(const CGpioSysfs&) = delete;             // copy constructor
+    CGpioSysfs& operator=(const CGpioSysfs&) = delete;  // copy operator
+    CGpioSysfs(CGpioSysfs&&) = delete;                  // move constructor
+    CGpioSysfs& operator=(CGpioSysfs&&) = delete;       // move operator
+
+    int get_fd( Tpin pin );
+
+private:
+    std::string _m_root_;
+
+    std::map<Tpin, int> _mm_fds_;
+
+    std::mutex _mtx_fds_;
+
+};
+
+
+/***
+ * GPIO character-device back-end : line of "${root}" (Ex: /dev/gpiochip0) is requested once as output,
+ *                                  and written by GPIOHANDLE_SET_LINE_VALUES_IOCTL.
+ ***/
+class CGpioChardev : public IGpio {
+public:
+    static constexpr const char* CONSUMER = "valve_controller";
+
+public:
+    explicit CGpioChardev( const std::string& root );
+
+    ~CGpioChardev(void);
+
+    const char* get_type(void) const override { return TYPE_CHARDEV; }
+
+    bool write( Tpin pin, int value ) override;
+
+    void close_all(void) override;
+
+private:
+    CGpioChardev(const CGpioChardev&) = delete;             // copy constructor
+    CGpioChardev& operator=(const CGpioChardev&) = delete;  // copy operator
+    CGpioChardev(CGpioChardev&&) = delete;                  // move constructor
+    CGpioChardev& operator=(CGpioChardev&&) = delete;       // move operator
+
+    /** return -1, if line is requested just now with value. (initial value is written by request.) */
+    int get_fd( Tpin pin, int value );
+
+private:
+    std::string _m_root_;
+
+    int _m_chip_fd_;
+
+    std::map<Tpin, int> _mm_fds_;
+
+    std::mutex _mtx_fds_;
+
+};
+
+
+/***
+ * In-memory back-end for testing & benchmark. (It does not access any device.)
+ ***/
+class CGpioFake : public IGpio {
+public:
+    CGpioFake(void) : _m_write_cnt_(0) {}
+
+    const char* get_type(void) const override { return TYPE_FAKE; }
+
+    bool write( Tpin pin, int value ) override;
+
+    void close_all(void) override;
+
+    /** return -1, if pin is not written yet. */
+    int get_value( Tpin pin );
+
+    uint64_t get_write_count(void);
+
+private:
+    std::map<Tpin, int> _mm_values_;
+
+    uint64_t _m_write_cnt_;
+
+    std::mutex _mtx_values_;
+
+};
+
+
+}   // namespace valve_pkg
+
+
+#endif // _VALVE_GPIO_H_
@@ -0,0 +1,80 @@
+#ifndef _VALVE_MAP_H_
+#define _VALVE_MAP_H_
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include <CGpio.h>
+
+namespace valve_pkg {
+
+
+/***
+ * Table of valves. (valve-id -> GPIO-pins, pulse-duration, active-level)
+ *  - It's loaded from json-file at start-up, or default-table is used if file is not given.
+ *  - valve-id is index of vector, so lookup is O(1).
+ *
+ *  json-format)
+ *   {
+ *     "indicator": 12,
+ *     "valves": [
+ *       { "id": 0, "open": 107, "close": 110, "pulse_open": 25, "pulse_close": 25, "active_level": 0 },
+ *       ...
+ *     ]
+ *   }
+ ***/
+class CValveMap {
+public:
+    using Tpin = IGpio::Tpin;
+
+    struct CValve {
+        bool valid;
+        Tpin open_pin;
+        Tpin close_pin;
+        uint32_t pulse_open;    // power-on duration for opening. [seconds]
+        uint32_t pulse_close;   // power-on duration for closing. [seconds]
+        int active_level;       // GPIO value of power-enable.
+    };
+
+    static constexpr uint32_t MAX_VALVE_CNT = 256;
+    static constexpr uint32_t DEFAULT_PULSE_SEC = 25;
+    static constexpr int DEFAULT_ACTIVE_LEVEL = 0;
+    static constexpr Tpin DEFAULT_INDICATOR_PIN = 12;
+
+public:
+    CValveMap(void);
+
+    /** Load table from json-file. (If path is empty, then default-table is loaded.) */
+    void load( const std::string& path );
+
+    /** throw CException(E_ERR_NOT_SUPPORTED_WHAT), if valve is not exist in table. */
+    const CValve& get( uint32_t valve_id ) const;
+
+    size_t size(void) const { return _m_valve_cnt_; }
+
+    Tpin get_indicator_pin(void) const { return _m_indicator_pin_; }
+
+    void clear(void);
+
+private:
+    void load_default(void);
+
+    void load_file( const std::string& path );
+
+    void set( uint32_t valve_id, const CValve& valve );
+
+private:
+    std::vector<CValve> _mv_valves_;
+
+    size_t _m_valve_cnt_;
+
+    Tpin _m_indicator_pin_;
+
+};
+
+
+}   // namespace valve_pkg
+
+
+#endif // _VALVE_MAP_H_
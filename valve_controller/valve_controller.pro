@@ -40,6 +40,7 @@ equals(CPU_ARCH,"x86") {
 equals(BUILD_MODE, "debug") {
     DEFINES += LOG_TIME_ENABLE
     DEFINES += LOG_DEBUG_MODE
+    DEFINES += LOG_ASYNC_ENABLE
     DEFINES += LOG_LEVEL=$$LOG_LEVEL_DEBUG
 }
 